@@ -14,6 +14,7 @@
         GL_ARB_fragment_program,
         GL_ARB_fragment_shader,
         GL_ARB_half_float_pixel,
+        GL_ARB_map_buffer_range,
         GL_ARB_multisample,
         GL_ARB_multitexture,
         GL_ARB_occlusion_query,
@@ -23,6 +24,7 @@
         GL_ARB_shader_objects,
         GL_ARB_shading_language_100,
         GL_ARB_shadow,
+        GL_ARB_sync,
         GL_ARB_texture_border_clamp,
         GL_ARB_texture_compression,
         GL_ARB_texture_cube_map,
@@ -34,7 +36,9 @@
         GL_ARB_texture_mirrored_repeat,
         GL_ARB_texture_non_power_of_two,
         GL_ARB_texture_rectangle,
+        GL_ARB_timer_query,
         GL_ARB_transpose_matrix,
+        GL_ARB_vertex_array_object,
         GL_ARB_vertex_buffer_object,
         GL_ARB_vertex_program,
         GL_ARB_vertex_shader,
@@ -75,6 +79,7 @@
         GL_EXT_texture_lod_bias,
         GL_EXT_texture_object,
         GL_EXT_texture_sRGB,
+        GL_EXT_timer_query,
         GL_EXT_vertex_array,
         GL_IBM_texture_mirrored_repeat,
         GL_NV_blend_square,
@@ -91,7 +96,7 @@
     Omit khrplatform: False
 
     Commandline:
-        --profile="core" --api="gl=2.1" --generator="c" --spec="gl" --extensions="GL_3DFX_texture_compression_FXT1,GL_ARB_color_buffer_float,GL_ARB_depth_texture,GL_ARB_draw_buffers,GL_ARB_fragment_program,GL_ARB_fragment_shader,GL_ARB_half_float_pixel,GL_ARB_multisample,GL_ARB_multitexture,GL_ARB_occlusion_query,GL_ARB_pixel_buffer_object,GL_ARB_point_parameters,GL_ARB_point_sprite,GL_ARB_shader_objects,GL_ARB_shading_language_100,GL_ARB_shadow,GL_ARB_texture_border_clamp,GL_ARB_texture_compression,GL_ARB_texture_cube_map,GL_ARB_texture_env_add,GL_ARB_texture_env_combine,GL_ARB_texture_env_crossbar,GL_ARB_texture_env_dot3,GL_ARB_texture_float,GL_ARB_texture_mirrored_repeat,GL_ARB_texture_non_power_of_two,GL_ARB_texture_rectangle,GL_ARB_transpose_matrix,GL_ARB_vertex_buffer_object,GL_ARB_vertex_program,GL_ARB_vertex_shader,GL_ARB_window_pos,GL_ATI_separate_stencil,GL_EXT_abgr,GL_EXT_bgra,GL_EXT_blend_color,GL_EXT_blend_equation_separate,GL_EXT_blend_func_separate,GL_EXT_blend_logic_op,GL_EXT_blend_minmax,GL_EXT_blend_subtract,GL_EXT_clip_volume_hint,GL_EXT_compiled_vertex_array,GL_EXT_copy_texture,GL_EXT_draw_range_elements,GL_EXT_fog_coord,GL_EXT_framebuffer_object,GL_EXT_multi_draw_arrays,GL_EXT_packed_pixels,GL_EXT_point_parameters,GL_EXT_polygon_offset,GL_EXT_rescale_normal,GL_EXT_secondary_color,GL_EXT_separate_specular_color,GL_EXT_shadow_funcs,GL_EXT_stencil_two_side,GL_EXT_stencil_wrap,GL_EXT_subtexture,GL_EXT_texture,GL_EXT_texture3D,GL_EXT_texture_compression_s3tc,GL_EXT_texture_env_add,GL_EXT_texture_env_combine,GL_EXT_texture_env_dot3,GL_EXT_texture_filter_anisotropic,GL_EXT_texture_lod_bias,GL_EXT_texture_object,GL_EXT_texture_sRGB,GL_EXT_vertex_array,GL_IBM_texture_mirrored_repeat,GL_NV_blend_square,GL_NV_point_sprite,GL_NV_texgen_reflection,GL_NV_texture_rectangle,GL_S3_s3tc,GL_SGIS_generate_mipmap,GL_SGIS_texture_edge_clamp,GL_SGIS_texture_lod,GL_SGIX_depth_texture"
+        --profile="core" --api="gl=2.1" --generator="c" --spec="gl" --extensions="GL_3DFX_texture_compression_FXT1,GL_ARB_color_buffer_float,GL_ARB_depth_texture,GL_ARB_draw_buffers,GL_ARB_fragment_program,GL_ARB_fragment_shader,GL_ARB_half_float_pixel,GL_ARB_map_buffer_range,GL_ARB_multisample,GL_ARB_multitexture,GL_ARB_occlusion_query,GL_ARB_pixel_buffer_object,GL_ARB_point_parameters,GL_ARB_point_sprite,GL_ARB_shader_objects,GL_ARB_shading_language_100,GL_ARB_shadow,GL_ARB_sync,GL_ARB_texture_border_clamp,GL_ARB_texture_compression,GL_ARB_texture_cube_map,GL_ARB_texture_env_add,GL_ARB_texture_env_combine,GL_ARB_texture_env_crossbar,GL_ARB_texture_env_dot3,GL_ARB_texture_float,GL_ARB_texture_mirrored_repeat,GL_ARB_texture_non_power_of_two,GL_ARB_texture_rectangle,GL_ARB_timer_query,GL_ARB_transpose_matrix,GL_ARB_vertex_array_object,GL_ARB_vertex_buffer_object,GL_ARB_vertex_program,GL_ARB_vertex_shader,GL_ARB_window_pos,GL_ATI_separate_stencil,GL_EXT_abgr,GL_EXT_bgra,GL_EXT_blend_color,GL_EXT_blend_equation_separate,GL_EXT_blend_func_separate,GL_EXT_blend_logic_op,GL_EXT_blend_minmax,GL_EXT_blend_subtract,GL_EXT_clip_volume_hint,GL_EXT_compiled_vertex_array,GL_EXT_copy_texture,GL_EXT_draw_range_elements,GL_EXT_fog_coord,GL_EXT_framebuffer_object,GL_EXT_multi_draw_arrays,GL_EXT_packed_pixels,GL_EXT_point_parameters,GL_EXT_polygon_offset,GL_EXT_rescale_normal,GL_EXT_secondary_color,GL_EXT_separate_specular_color,GL_EXT_shadow_funcs,GL_EXT_stencil_two_side,GL_EXT_stencil_wrap,GL_EXT_subtexture,GL_EXT_texture,GL_EXT_texture3D,GL_EXT_texture_compression_s3tc,GL_EXT_texture_env_add,GL_EXT_texture_env_combine,GL_EXT_texture_env_dot3,GL_EXT_texture_filter_anisotropic,GL_EXT_texture_lod_bias,GL_EXT_texture_object,GL_EXT_texture_sRGB,GL_EXT_timer_query,GL_EXT_vertex_array,GL_IBM_texture_mirrored_repeat,GL_NV_blend_square,GL_NV_point_sprite,GL_NV_texgen_reflection,GL_NV_texture_rectangle,GL_S3_s3tc,GL_SGIS_generate_mipmap,GL_SGIS_texture_edge_clamp,GL_SGIS_texture_lod,GL_SGIX_depth_texture"
     Online:
         Too many extensions
 */
@@ -601,6 +606,11 @@ int GLAD_GL_ARB_pixel_buffer_object;
 int GLAD_GL_EXT_fog_coord;
 int GLAD_GL_ARB_point_parameters;
 int GLAD_GL_EXT_texture_env_dot3;
+int GLAD_GL_ARB_map_buffer_range;
+int GLAD_GL_ARB_sync;
+int GLAD_GL_ARB_vertex_array_object;
+int GLAD_GL_ARB_timer_query;
+int GLAD_GL_EXT_timer_query;
 PFNGLCLAMPCOLORARBPROC glad_glClampColorARB;
 PFNGLDRAWBUFFERSARBPROC glad_glDrawBuffersARB;
 PFNGLPROGRAMSTRINGARBPROC glad_glProgramStringARB;
@@ -870,6 +880,24 @@ PFNGLTEXCOORDPOINTEREXTPROC glad_glTexCoordPointerEXT;
 PFNGLVERTEXPOINTEREXTPROC glad_glVertexPointerEXT;
 PFNGLPOINTPARAMETERINVPROC glad_glPointParameteriNV;
 PFNGLPOINTPARAMETERIVNVPROC glad_glPointParameterivNV;
+PFNGLMAPBUFFERRANGEPROC glad_glMapBufferRange;
+PFNGLFLUSHMAPPEDBUFFERRANGEPROC glad_glFlushMappedBufferRange;
+PFNGLFENCESYNCPROC glad_glFenceSync;
+PFNGLISSYNCPROC glad_glIsSync;
+PFNGLDELETESYNCPROC glad_glDeleteSync;
+PFNGLCLIENTWAITSYNCPROC glad_glClientWaitSync;
+PFNGLWAITSYNCPROC glad_glWaitSync;
+PFNGLGETINTEGER64VPROC glad_glGetInteger64v;
+PFNGLGETSYNCIVPROC glad_glGetSynciv;
+PFNGLBINDVERTEXARRAYPROC glad_glBindVertexArray;
+PFNGLDELETEVERTEXARRAYSPROC glad_glDeleteVertexArrays;
+PFNGLGENVERTEXARRAYSPROC glad_glGenVertexArrays;
+PFNGLISVERTEXARRAYPROC glad_glIsVertexArray;
+PFNGLQUERYCOUNTERPROC glad_glQueryCounter;
+PFNGLGETQUERYOBJECTI64VPROC glad_glGetQueryObjecti64v;
+PFNGLGETQUERYOBJECTUI64VPROC glad_glGetQueryObjectui64v;
+PFNGLGETQUERYOBJECTI64VEXTPROC glad_glGetQueryObjecti64vEXT;
+PFNGLGETQUERYOBJECTUI64VEXTPROC glad_glGetQueryObjectui64vEXT;
 static void load_GL_VERSION_1_0(GLADloadproc load) {
 	if(!GLAD_GL_VERSION_1_0) return;
 	glad_glCullFace = (PFNGLCULLFACEPROC)load("glCullFace");
@@ -1125,6 +1153,11 @@ static void load_GL_ARB_fragment_program(GLADloadproc load) {
 	glad_glGetProgramStringARB = (PFNGLGETPROGRAMSTRINGARBPROC)load("glGetProgramStringARB");
 	glad_glIsProgramARB = (PFNGLISPROGRAMARBPROC)load("glIsProgramARB");
 }
+static void load_GL_ARB_map_buffer_range(GLADloadproc load) {
+	if(!GLAD_GL_ARB_map_buffer_range) return;
+	glad_glMapBufferRange = (PFNGLMAPBUFFERRANGEPROC)load("glMapBufferRange");
+	glad_glFlushMappedBufferRange = (PFNGLFLUSHMAPPEDBUFFERRANGEPROC)load("glFlushMappedBufferRange");
+}
 static void load_GL_ARB_multisample(GLADloadproc load) {
 	if(!GLAD_GL_ARB_multisample) return;
 	glad_glSampleCoverageARB = (PFNGLSAMPLECOVERAGEARBPROC)load("glSampleCoverageARB");
@@ -1224,6 +1257,16 @@ static void load_GL_ARB_shader_objects(GLADloadproc load) {
 	glad_glGetUniformivARB = (PFNGLGETUNIFORMIVARBPROC)load("glGetUniformivARB");
 	glad_glGetShaderSourceARB = (PFNGLGETSHADERSOURCEARBPROC)load("glGetShaderSourceARB");
 }
+static void load_GL_ARB_sync(GLADloadproc load) {
+	if(!GLAD_GL_ARB_sync) return;
+	glad_glFenceSync = (PFNGLFENCESYNCPROC)load("glFenceSync");
+	glad_glIsSync = (PFNGLISSYNCPROC)load("glIsSync");
+	glad_glDeleteSync = (PFNGLDELETESYNCPROC)load("glDeleteSync");
+	glad_glClientWaitSync = (PFNGLCLIENTWAITSYNCPROC)load("glClientWaitSync");
+	glad_glWaitSync = (PFNGLWAITSYNCPROC)load("glWaitSync");
+	glad_glGetInteger64v = (PFNGLGETINTEGER64VPROC)load("glGetInteger64v");
+	glad_glGetSynciv = (PFNGLGETSYNCIVPROC)load("glGetSynciv");
+}
 static void load_GL_ARB_texture_compression(GLADloadproc load) {
 	if(!GLAD_GL_ARB_texture_compression) return;
 	glad_glCompressedTexImage3DARB = (PFNGLCOMPRESSEDTEXIMAGE3DARBPROC)load("glCompressedTexImage3DARB");
@@ -1234,6 +1277,12 @@ static void load_GL_ARB_texture_compression(GLADloadproc load) {
 	glad_glCompressedTexSubImage1DARB = (PFNGLCOMPRESSEDTEXSUBIMAGE1DARBPROC)load("glCompressedTexSubImage1DARB");
 	glad_glGetCompressedTexImageARB = (PFNGLGETCOMPRESSEDTEXIMAGEARBPROC)load("glGetCompressedTexImageARB");
 }
+static void load_GL_ARB_timer_query(GLADloadproc load) {
+	if(!GLAD_GL_ARB_timer_query) return;
+	glad_glQueryCounter = (PFNGLQUERYCOUNTERPROC)load("glQueryCounter");
+	glad_glGetQueryObjecti64v = (PFNGLGETQUERYOBJECTI64VPROC)load("glGetQueryObjecti64v");
+	glad_glGetQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VPROC)load("glGetQueryObjectui64v");
+}
 static void load_GL_ARB_transpose_matrix(GLADloadproc load) {
 	if(!GLAD_GL_ARB_transpose_matrix) return;
 	glad_glLoadTransposeMatrixfARB = (PFNGLLOADTRANSPOSEMATRIXFARBPROC)load("glLoadTransposeMatrixfARB");
@@ -1241,6 +1290,13 @@ static void load_GL_ARB_transpose_matrix(GLADloadproc load) {
 	glad_glMultTransposeMatrixfARB = (PFNGLMULTTRANSPOSEMATRIXFARBPROC)load("glMultTransposeMatrixfARB");
 	glad_glMultTransposeMatrixdARB = (PFNGLMULTTRANSPOSEMATRIXDARBPROC)load("glMultTransposeMatrixdARB");
 }
+static void load_GL_ARB_vertex_array_object(GLADloadproc load) {
+	if(!GLAD_GL_ARB_vertex_array_object) return;
+	glad_glBindVertexArray = (PFNGLBINDVERTEXARRAYPROC)load("glBindVertexArray");
+	glad_glDeleteVertexArrays = (PFNGLDELETEVERTEXARRAYSPROC)load("glDeleteVertexArrays");
+	glad_glGenVertexArrays = (PFNGLGENVERTEXARRAYSPROC)load("glGenVertexArrays");
+	glad_glIsVertexArray = (PFNGLISVERTEXARRAYPROC)load("glIsVertexArray");
+}
 static void load_GL_ARB_vertex_buffer_object(GLADloadproc load) {
 	if(!GLAD_GL_ARB_vertex_buffer_object) return;
 	glad_glBindBufferARB = (PFNGLBINDBUFFERARBPROC)load("glBindBufferARB");
@@ -1511,6 +1567,11 @@ static void load_GL_EXT_texture_object(GLADloadproc load) {
 	glad_glIsTextureEXT = (PFNGLISTEXTUREEXTPROC)load("glIsTextureEXT");
 	glad_glPrioritizeTexturesEXT = (PFNGLPRIORITIZETEXTURESEXTPROC)load("glPrioritizeTexturesEXT");
 }
+static void load_GL_EXT_timer_query(GLADloadproc load) {
+	if(!GLAD_GL_EXT_timer_query) return;
+	glad_glGetQueryObjecti64vEXT = (PFNGLGETQUERYOBJECTI64VEXTPROC)load("glGetQueryObjecti64vEXT");
+	glad_glGetQueryObjectui64vEXT = (PFNGLGETQUERYOBJECTUI64VEXTPROC)load("glGetQueryObjectui64vEXT");
+}
 static void load_GL_EXT_vertex_array(GLADloadproc load) {
 	if(!GLAD_GL_EXT_vertex_array) return;
 	glad_glArrayElementEXT = (PFNGLARRAYELEMENTEXTPROC)load("glArrayElementEXT");
@@ -1537,6 +1598,7 @@ static int find_extensionsGL(void) {
 	GLAD_GL_ARB_fragment_program = has_ext("GL_ARB_fragment_program");
 	GLAD_GL_ARB_fragment_shader = has_ext("GL_ARB_fragment_shader");
 	GLAD_GL_ARB_half_float_pixel = has_ext("GL_ARB_half_float_pixel");
+	GLAD_GL_ARB_map_buffer_range = has_ext("GL_ARB_map_buffer_range");
 	GLAD_GL_ARB_multisample = has_ext("GL_ARB_multisample");
 	GLAD_GL_ARB_multitexture = has_ext("GL_ARB_multitexture");
 	GLAD_GL_ARB_occlusion_query = has_ext("GL_ARB_occlusion_query");
@@ -1546,6 +1608,7 @@ static int find_extensionsGL(void) {
 	GLAD_GL_ARB_shader_objects = has_ext("GL_ARB_shader_objects");
 	GLAD_GL_ARB_shading_language_100 = has_ext("GL_ARB_shading_language_100");
 	GLAD_GL_ARB_shadow = has_ext("GL_ARB_shadow");
+	GLAD_GL_ARB_sync = has_ext("GL_ARB_sync");
 	GLAD_GL_ARB_texture_border_clamp = has_ext("GL_ARB_texture_border_clamp");
 	GLAD_GL_ARB_texture_compression = has_ext("GL_ARB_texture_compression");
 	GLAD_GL_ARB_texture_cube_map = has_ext("GL_ARB_texture_cube_map");
@@ -1557,7 +1620,9 @@ static int find_extensionsGL(void) {
 	GLAD_GL_ARB_texture_mirrored_repeat = has_ext("GL_ARB_texture_mirrored_repeat");
 	GLAD_GL_ARB_texture_non_power_of_two = has_ext("GL_ARB_texture_non_power_of_two");
 	GLAD_GL_ARB_texture_rectangle = has_ext("GL_ARB_texture_rectangle");
+	GLAD_GL_ARB_timer_query = has_ext("GL_ARB_timer_query");
 	GLAD_GL_ARB_transpose_matrix = has_ext("GL_ARB_transpose_matrix");
+	GLAD_GL_ARB_vertex_array_object = has_ext("GL_ARB_vertex_array_object");
 	GLAD_GL_ARB_vertex_buffer_object = has_ext("GL_ARB_vertex_buffer_object");
 	GLAD_GL_ARB_vertex_program = has_ext("GL_ARB_vertex_program");
 	GLAD_GL_ARB_vertex_shader = has_ext("GL_ARB_vertex_shader");
@@ -1598,6 +1663,7 @@ static int find_extensionsGL(void) {
 	GLAD_GL_EXT_texture_lod_bias = has_ext("GL_EXT_texture_lod_bias");
 	GLAD_GL_EXT_texture_object = has_ext("GL_EXT_texture_object");
 	GLAD_GL_EXT_texture_sRGB = has_ext("GL_EXT_texture_sRGB");
+	GLAD_GL_EXT_timer_query = has_ext("GL_EXT_timer_query");
 	GLAD_GL_EXT_vertex_array = has_ext("GL_EXT_vertex_array");
 	GLAD_GL_IBM_texture_mirrored_repeat = has_ext("GL_IBM_texture_mirrored_repeat");
 	GLAD_GL_NV_blend_square = has_ext("GL_NV_blend_square");
@@ -1682,13 +1748,17 @@ int gladLoadGLLoader(GLADloadproc load) {
 	load_GL_ARB_color_buffer_float(load);
 	load_GL_ARB_draw_buffers(load);
 	load_GL_ARB_fragment_program(load);
+	load_GL_ARB_map_buffer_range(load);
 	load_GL_ARB_multisample(load);
 	load_GL_ARB_multitexture(load);
 	load_GL_ARB_occlusion_query(load);
 	load_GL_ARB_point_parameters(load);
 	load_GL_ARB_shader_objects(load);
+	load_GL_ARB_sync(load);
 	load_GL_ARB_texture_compression(load);
+	load_GL_ARB_timer_query(load);
 	load_GL_ARB_transpose_matrix(load);
+	load_GL_ARB_vertex_array_object(load);
 	load_GL_ARB_vertex_buffer_object(load);
 	load_GL_ARB_vertex_program(load);
 	load_GL_ARB_vertex_shader(load);
@@ -1711,6 +1781,7 @@ int gladLoadGLLoader(GLADloadproc load) {
 	load_GL_EXT_subtexture(load);
 	load_GL_EXT_texture3D(load);
 	load_GL_EXT_texture_object(load);
+	load_GL_EXT_timer_query(load);
 	load_GL_EXT_vertex_array(load);
 	load_GL_NV_point_sprite(load);
 	return GLVersion.major != 0 || GLVersion.minor != 0;
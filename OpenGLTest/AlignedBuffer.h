@@ -0,0 +1,96 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+/*
+ * A fixed-size array of plain elements, starting at a 64-byte boundary - a cache
+ * line, and the width of the widest SIMD registers - so that loops over it may be
+ * vectorized with aligned accesses and no peeling.
+ *
+ * The allocation is rounded up to a multiple of the alignment, hence the last
+ * vector of a loop may safely read past the last element.
+ */
+template<typename TElement>
+class AlignedBuffer
+{
+    static_assert(std::is_trivially_copyable<TElement>::value, "AlignedBuffer elements must be trivially copyable");
+    static_assert(std::is_trivially_destructible<TElement>::value, "AlignedBuffer elements must be trivially destructible");
+
+public:
+
+    static constexpr size_t Alignment = 64;
+
+    explicit AlignedBuffer(size_t size)
+        : mSize(size)
+        , mBuffer(static_cast<TElement *>(::operator new(GetAllocationSize(size), std::align_val_t(Alignment))))
+    {
+        std::uninitialized_fill_n(mBuffer, size, TElement());
+    }
+
+    ~AlignedBuffer()
+    {
+        ::operator delete(mBuffer, std::align_val_t(Alignment));
+    }
+
+    AlignedBuffer(AlignedBuffer const & other) = delete;
+    AlignedBuffer & operator=(AlignedBuffer const & other) = delete;
+
+    size_t size() const
+    {
+        return mSize;
+    }
+
+    /*
+     * The bytes allocated, including the rounding up.
+     */
+    size_t GetAllocationSize() const
+    {
+        return GetAllocationSize(mSize);
+    }
+
+    TElement * data()
+    {
+        return mBuffer;
+    }
+
+    TElement const * data() const
+    {
+        return mBuffer;
+    }
+
+    TElement & operator[](size_t index)
+    {
+        assert(index < mSize);
+        return mBuffer[index];
+    }
+
+    TElement const & operator[](size_t index) const
+    {
+        assert(index < mSize);
+        return mBuffer[index];
+    }
+
+private:
+
+    static size_t GetAllocationSize(size_t size)
+    {
+        size_t const allocationSize = ((size * sizeof(TElement) + Alignment - 1) / Alignment) * Alignment;
+
+        // Never zero, so that even an empty buffer has an aligned address
+        return allocationSize > 0 ? allocationSize : Alignment;
+    }
+
+private:
+
+    size_t const mSize;
+    TElement * const mBuffer;
+};
@@ -0,0 +1,64 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "AlignedBuffer.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * A fixed-size set of flags, packed 64 to a word, all clear at the start.
+ */
+class Bitset
+{
+public:
+
+    static constexpr size_t BitsPerWord = 64;
+
+    explicit Bitset(size_t size)
+        : mSize(size)
+        , mWords((size + BitsPerWord - 1) / BitsPerWord)
+    {}
+
+    Bitset(Bitset const & other) = delete;
+    Bitset & operator=(Bitset const & other) = delete;
+
+    size_t GetSize() const
+    {
+        return mSize;
+    }
+
+    size_t GetAllocationSize() const
+    {
+        return mWords.GetAllocationSize();
+    }
+
+    bool Test(size_t index) const
+    {
+        assert(index < mSize);
+        return 0 != (mWords[index / BitsPerWord] & (uint64_t(1) << (index % BitsPerWord)));
+    }
+
+    void Set(
+        size_t index,
+        bool value)
+    {
+        assert(index < mSize);
+
+        uint64_t const mask = uint64_t(1) << (index % BitsPerWord);
+        if (value)
+            mWords[index / BitsPerWord] |= mask;
+        else
+            mWords[index / BitsPerWord] &= ~mask;
+    }
+
+private:
+
+    size_t const mSize;
+    AlignedBuffer<uint64_t> mWords;
+};
@@ -0,0 +1,125 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "FrameStatistics.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+
+namespace /* anonymous */ {
+
+    /*
+     * Nearest-rank percentile of an ascending sequence.
+     */
+    float GetPercentile(
+        std::vector<float> const & sortedValues,
+        size_t count,
+        float percentile)
+    {
+        assert(count > 0 && count <= sortedValues.size());
+
+        size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0f * static_cast<float>(count)));
+        rank = std::max(rank, size_t(1));
+        return sortedValues[std::min(rank, count) - 1];
+    }
+}
+
+std::string FrameStatistics::Summary::ToJson() const
+{
+    char buffer[512];
+    snprintf(buffer, sizeof(buffer),
+        "{\"frames\": %zu, \"mean\": %.4f, \"min\": %.4f, \"p50\": %.4f, \"p90\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f, \"hitches\": %zu, \"hitch_budget\": %.4f}",
+        FrameCount,
+        Mean,
+        Min,
+        P50,
+        P90,
+        P95,
+        P99,
+        Max,
+        Hitches,
+        HitchBudget);
+
+    return std::string(buffer);
+}
+
+FrameStatistics::FrameStatistics(
+    size_t capacity,
+    float hitchBudget)
+    : mFrameTimes(capacity, 0.0f)
+    , mFrameTimeCount(0u)
+    , mNextFrameTime(0u)
+    , mHitchBudget(hitchBudget)
+    , mTotalHitches(0u)
+    , mLastTimestamp()
+    , mHasLastTimestamp(false)
+    , mSortedFrameTimes(capacity, 0.0f)
+{
+    assert(capacity > 0);
+}
+
+void FrameStatistics::OnFrame(std::chrono::steady_clock::time_point timestamp)
+{
+    if (mHasLastTimestamp)
+    {
+        AddFrameTime(std::chrono::duration<float, std::milli>(timestamp - mLastTimestamp).count());
+    }
+
+    mLastTimestamp = timestamp;
+    mHasLastTimestamp = true;
+}
+
+void FrameStatistics::AddFrameTime(float frameTime)
+{
+    mFrameTimes[mNextFrameTime] = frameTime;
+    mNextFrameTime = (mNextFrameTime + 1) % mFrameTimes.size();
+    mFrameTimeCount = std::min(mFrameTimeCount + 1, mFrameTimes.size());
+
+    if (frameTime > mHitchBudget)
+        ++mTotalHitches;
+}
+
+void FrameStatistics::Reset()
+{
+    mFrameTimeCount = 0u;
+    mNextFrameTime = 0u;
+    mTotalHitches = 0u;
+    mHasLastTimestamp = false;
+}
+
+FrameStatistics::Summary FrameStatistics::GetSummary() const
+{
+    Summary summary;
+    summary.HitchBudget = mHitchBudget;
+
+    if (0u == mFrameTimeCount)
+        return summary;
+
+    // The frames in the ring are the first mFrameTimeCount ones, in some order
+    double totalTime = 0.0;
+    for (size_t f = 0; f < mFrameTimeCount; ++f)
+    {
+        mSortedFrameTimes[f] = mFrameTimes[f];
+        totalTime += mFrameTimes[f];
+
+        if (mFrameTimes[f] > mHitchBudget)
+            ++summary.Hitches;
+    }
+
+    std::sort(mSortedFrameTimes.begin(), mSortedFrameTimes.begin() + mFrameTimeCount);
+
+    summary.FrameCount = mFrameTimeCount;
+    summary.Mean = static_cast<float>(totalTime / static_cast<double>(mFrameTimeCount));
+    summary.Min = mSortedFrameTimes[0];
+    summary.P50 = GetPercentile(mSortedFrameTimes, mFrameTimeCount, 50.0f);
+    summary.P90 = GetPercentile(mSortedFrameTimes, mFrameTimeCount, 90.0f);
+    summary.P95 = GetPercentile(mSortedFrameTimes, mFrameTimeCount, 95.0f);
+    summary.P99 = GetPercentile(mSortedFrameTimes, mFrameTimeCount, 99.0f);
+    summary.Max = mSortedFrameTimes[mFrameTimeCount - 1];
+
+    return summary;
+}
@@ -0,0 +1,110 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+ * The durations of the most recent frames, kept in a fixed-size ring, from which
+ * percentiles and hitches - frames over budget - are calculated.
+ *
+ * Frames are fed either as one timestamp per frame, from which the durations are
+ * derived, or directly as durations.
+ */
+class FrameStatistics
+{
+public:
+
+    // All times are in milliseconds
+    struct Summary
+    {
+        size_t FrameCount;
+        float Mean;
+        float Min;
+        float P50;
+        float P90;
+        float P95;
+        float P99;
+        float Max;
+
+        // Frames over the budget, among the ones above
+        size_t Hitches;
+        float HitchBudget;
+
+        Summary()
+            : FrameCount(0u)
+            , Mean(0.0f)
+            , Min(0.0f)
+            , P50(0.0f)
+            , P90(0.0f)
+            , P95(0.0f)
+            , P99(0.0f)
+            , Max(0.0f)
+            , Hitches(0u)
+            , HitchBudget(0.0f)
+        {}
+
+        std::string ToJson() const;
+    };
+
+public:
+
+    FrameStatistics(
+        size_t capacity,
+        float hitchBudget);
+
+    /*
+     * Marks the end of a frame; the frame's duration is the time since the previous
+     * timestamp. The first timestamp only starts the clock.
+     */
+    void OnFrame(std::chrono::steady_clock::time_point timestamp);
+
+    void AddFrameTime(float frameTime);
+
+    /*
+     * Forgets all frames, and restarts the clock.
+     */
+    void Reset();
+
+    float GetHitchBudget() const
+    {
+        return mHitchBudget;
+    }
+
+    void SetHitchBudget(float hitchBudget)
+    {
+        mHitchBudget = hitchBudget;
+    }
+
+    /*
+     * Hitches since the last reset, including those that have left the ring.
+     */
+    uint64_t GetTotalHitches() const
+    {
+        return mTotalHitches;
+    }
+
+    Summary GetSummary() const;
+
+private:
+
+    std::vector<float> mFrameTimes;
+    size_t mFrameTimeCount;
+    size_t mNextFrameTime;
+
+    float mHitchBudget;
+    uint64_t mTotalHitches;
+
+    std::chrono::steady_clock::time_point mLastTimestamp;
+    bool mHasLastTimestamp;
+
+    // Scratch space for sorting, so that summaries don't allocate
+    mutable std::vector<float> mSortedFrameTimes;
+};
@@ -0,0 +1,134 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "GpuPassTimer.h"
+
+#include <cassert>
+
+GpuPassTimer::GpuPassTimer(size_t passCount)
+    : mIsSupported(GLAD_GL_ARB_timer_query || GLAD_GL_EXT_timer_query)
+    , mPassCount(passCount)
+    , mQueries()
+    , mIsQueryIssued(FrameCount * passCount, false)
+    , mCurrentFrame(0u)
+    , mActiveQuery(0u)
+    , mSamples(passCount * AverageWindow, 0u)
+    , mSampleSums(passCount, 0u)
+    , mSampleCounts(passCount, 0u)
+    , mNextSamples(passCount, 0u)
+    , mStatistics()
+{
+    if (mIsSupported)
+    {
+        mQueries.resize(FrameCount * passCount);
+        glGenQueries(static_cast<GLsizei>(mQueries.size()), mQueries.data());
+    }
+}
+
+GpuPassTimer::~GpuPassTimer()
+{
+    if (!mQueries.empty())
+    {
+        glDeleteQueries(static_cast<GLsizei>(mQueries.size()), mQueries.data());
+    }
+}
+
+void GpuPassTimer::BeginFrame()
+{
+    if (!mIsSupported)
+        return;
+
+    assert(0u == mActiveQuery);
+
+    mCurrentFrame = (mCurrentFrame + 1) % FrameCount;
+
+    CollectFrame(mCurrentFrame);
+}
+
+void GpuPassTimer::BeginPass(size_t pass)
+{
+    assert(pass < mPassCount);
+
+    if (!mIsSupported)
+        return;
+
+    assert(0u == mActiveQuery);
+
+    size_t const q = mCurrentFrame * mPassCount + pass;
+    if (mIsQueryIssued[q])
+        return;
+
+    glBeginQuery(GL_TIME_ELAPSED, mQueries[q]);
+
+    mActiveQuery = mQueries[q];
+    mIsQueryIssued[q] = true;
+}
+
+void GpuPassTimer::EndPass()
+{
+    if (0u == mActiveQuery)
+        return;
+
+    glEndQuery(GL_TIME_ELAPSED);
+
+    mActiveQuery = 0u;
+}
+
+float GpuPassTimer::GetAveragePassTime(size_t pass) const
+{
+    assert(pass < mPassCount);
+
+    if (0u == mSampleCounts[pass])
+        return 0.0f;
+
+    return static_cast<float>(
+        static_cast<double>(mSampleSums[pass]) / static_cast<double>(mSampleCounts[pass]) / 1000000.0);
+}
+
+void GpuPassTimer::CollectFrame(size_t frame)
+{
+    for (size_t pass = 0; pass < mPassCount; ++pass)
+    {
+        size_t const q = frame * mPassCount + pass;
+        if (!mIsQueryIssued[q])
+            continue;
+
+        mIsQueryIssued[q] = false;
+
+        GLuint isAvailable = GL_FALSE;
+        glGetQueryObjectuiv(mQueries[q], GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+        if (GL_FALSE == isAvailable)
+        {
+            // Rather than waiting for it, we let it go; the query gets re-used
+            ++mStatistics.DroppedSamples;
+            continue;
+        }
+
+        GLuint64 nanoseconds = 0u;
+        if (GLAD_GL_ARB_timer_query)
+            glGetQueryObjectui64v(mQueries[q], GL_QUERY_RESULT, &nanoseconds);
+        else
+            glGetQueryObjectui64vEXT(mQueries[q], GL_QUERY_RESULT, &nanoseconds);
+
+        AddSample(pass, nanoseconds);
+    }
+}
+
+void GpuPassTimer::AddSample(
+    size_t pass,
+    uint64_t nanoseconds)
+{
+    uint64_t & slot = mSamples[pass * AverageWindow + mNextSamples[pass]];
+
+    mSampleSums[pass] -= slot;
+    mSampleSums[pass] += nanoseconds;
+    slot = nanoseconds;
+
+    mNextSamples[pass] = (mNextSamples[pass] + 1) % AverageWindow;
+    if (mSampleCounts[pass] < AverageWindow)
+        ++mSampleCounts[pass];
+
+    ++mStatistics.Samples;
+}
@@ -0,0 +1,110 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "OpenGLTest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+ * Measures the GPU time taken by each of a fixed number of passes, by means of
+ * GL_TIME_ELAPSED queries (ARB_timer_query or EXT_timer_query).
+ *
+ * The queries of each frame go into a ring a few frames deep, and are only read
+ * back when their slot comes round again - by then the GPU is done with them, so
+ * reading never stalls the pipeline. A result that is still not available at that
+ * point is dropped.
+ *
+ * Without timer queries all the methods do nothing, and all times are zero.
+ */
+class GpuPassTimer
+{
+public:
+
+    struct Statistics
+    {
+        uint64_t Samples;
+        uint64_t DroppedSamples;
+
+        Statistics()
+            : Samples(0u)
+            , DroppedSamples(0u)
+        {}
+    };
+
+public:
+
+    explicit GpuPassTimer(size_t passCount);
+
+    ~GpuPassTimer();
+
+    GpuPassTimer(GpuPassTimer const & other) = delete;
+    GpuPassTimer & operator=(GpuPassTimer const & other) = delete;
+
+    bool IsSupported() const
+    {
+        return mIsSupported;
+    }
+
+    /*
+     * Moves on to the next slot in the ring, collecting the results that were
+     * stored there.
+     */
+    void BeginFrame();
+
+    /*
+     * Starts timing the specified pass; only one pass may be timed at any time,
+     * and only the first time a pass is timed in a frame counts.
+     */
+    void BeginPass(size_t pass);
+
+    void EndPass();
+
+    /*
+     * The average GPU time of the pass over the most recent frames, in milliseconds.
+     */
+    float GetAveragePassTime(size_t pass) const;
+
+    Statistics const & GetStatistics() const
+    {
+        return mStatistics;
+    }
+
+private:
+
+    void CollectFrame(size_t frame);
+
+    void AddSample(
+        size_t pass,
+        uint64_t nanoseconds);
+
+private:
+
+    static constexpr size_t FrameCount = 4;
+    static constexpr size_t AverageWindow = 32;
+
+    bool const mIsSupported;
+    size_t const mPassCount;
+
+    // FrameCount x PassCount queries, and whether each was issued in its frame
+    std::vector<GLuint> mQueries;
+    std::vector<bool> mIsQueryIssued;
+
+    size_t mCurrentFrame;
+
+    // The query currently being timed, if any
+    GLuint mActiveQuery;
+
+    // PassCount x AverageWindow samples
+    std::vector<uint64_t> mSamples;
+    std::vector<uint64_t> mSampleSums;
+    std::vector<size_t> mSampleCounts;
+    std::vector<size_t> mNextSamples;
+
+    Statistics mStatistics;
+};
@@ -1,25 +1,78 @@
 #include "MainFrame.h"
+#include "World.h"
 
 #include <wx/app.h>
+#include <wx/cmdline.h>
 #include <wx/msgdlg.h>
 
 class MainApp : public wxApp
 {
 public:
+
+    MainApp()
+        : mWorldWidth(World::DefaultWorldWidth)
+        , mWorldHeight(World::DefaultWorldHeight)
+    {}
+
 	virtual bool OnInit() override;
+
+    virtual void OnInitCmdLine(wxCmdLineParser & parser) override;
+
+    virtual bool OnCmdLineParsed(wxCmdLineParser & parser) override;
+
+private:
+
+    int mWorldWidth;
+    int mWorldHeight;
 };
 
 IMPLEMENT_APP(MainApp);
 
 bool MainApp::OnInit()
 {
+    // Parses the command line
+    if (!wxApp::OnInit())
+        return false;
+
     //
     // Create frame and start
     //
 
-	MainFrame* frame = new MainFrame();
+	MainFrame* frame = new MainFrame(mWorldWidth, mWorldHeight);
     frame->Show();
     SetTopWindow(frame);
 
 	return true;
-}
\ No newline at end of file
+}
+
+void MainApp::OnInitCmdLine(wxCmdLineParser & parser)
+{
+    wxApp::OnInitCmdLine(parser);
+
+    parser.AddOption(wxEmptyString, "world-size", "Number of columns and rows of ship points, as WIDTHxHEIGHT (default: 140x110)");
+    parser.AddOption(wxEmptyString, "world-scale", "Use this many times the default number of ship points, with the same aspect ratio", wxCMD_LINE_VAL_DOUBLE);
+}
+
+bool MainApp::OnCmdLineParsed(wxCmdLineParser & parser)
+{
+    if (!wxApp::OnCmdLineParsed(parser))
+        return false;
+
+    wxString worldSize;
+    if (parser.Found("world-size", &worldSize)
+        && !World::ParseWorldSize(worldSize.ToStdString(), mWorldWidth, mWorldHeight))
+    {
+        wxMessageBox("Invalid world size \"" + worldSize + "\"", "ERROR");
+        return false;
+    }
+
+    double worldScale;
+    if (parser.Found("world-scale", &worldScale)
+        && !World::GetScaledWorldSize(static_cast<float>(worldScale), mWorldWidth, mWorldHeight))
+    {
+        wxMessageBox(wxString::Format("Invalid world scale %g", worldScale), "ERROR");
+        return false;
+    }
+
+    return true;
+}
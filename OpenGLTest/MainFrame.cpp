@@ -2,6 +2,9 @@
 
 #include "MainFrame.h"
 
+#include "Profiler.h"
+
+#include <wx/clipbrd.h>
 #include <wx/intl.h>
 #include <wx/msgdlg.h>
 #include <wx/panel.h>
@@ -11,6 +14,8 @@
 
 #include <cassert>
 #include <chrono>
+#include <cstdio>
+#include <iomanip>
 #include <sstream>
 
 namespace /* anonymous */ {
@@ -26,17 +31,25 @@ const long ID_MAIN_CANVAS = wxNewId();
 const long ID_QUIT_MENUITEM = wxNewId();
 const long ID_TRANSPARENT_WATER_MENUITEM = wxNewId();
 const long ID_DRAW_ONLY_POINTS_MENUITEM = wxNewId();
+const long ID_GPU_WATER_MENUITEM = wxNewId();
+const long ID_PERFORMANCE_OVERLAY_MENUITEM = wxNewId();
+const long ID_SAVE_PROFILE_TRACE_MENUITEM = wxNewId();
+const long ID_COPY_FRAME_STATISTICS_MENUITEM = wxNewId();
+const long ID_COPY_MEMORY_REPORT_MENUITEM = wxNewId();
+const long ID_RECORD_RENDER_COMMANDS_MENUITEM = wxNewId();
 const long ID_ABOUT_MENUITEM = wxNewId();
 
 const long ID_GAME_TIMER = wxNewId();
 const long ID_STATS_REFRESH_TIMER = wxNewId();
 
-MainFrame::MainFrame()
-	: mIsWaterTransparent(false)
-    , mDrawOnlyPoints(false)
+MainFrame::MainFrame(
+    int worldWidth,
+    int worldHeight)
+	: mWorld(std::make_unique<World>(worldWidth, worldHeight))
     , mMouseInfo()
 	, mFrameCount(0u)
-    , mCurrentTime(0.0f)
+    , mFrameStatistics(300u, 1000.0f / 60.0f) // 5 seconds at 60 FPS
+    , mLastShipPointStreamStatistics()
 {
 	Create(
 		nullptr, 
@@ -118,26 +131,49 @@ MainFrame::MainFrame()
 
     wxMenuItem* transparentWaterMenuItem = new wxMenuItem(controlMenu, ID_TRANSPARENT_WATER_MENUITEM, _("Transparent Water\tW"), _("Make water transparent"), wxITEM_CHECK);
     controlMenu->Append(transparentWaterMenuItem);
-    transparentWaterMenuItem->Check(false);
+    transparentWaterMenuItem->Check(mWorld->GetIsWaterTransparent());
     this->Bind(
         wxEVT_MENU,
         [this](wxCommandEvent & event)
         {
-            this->mIsWaterTransparent = event.IsChecked();
+            this->mWorld->SetIsWaterTransparent(event.IsChecked());
         },
         ID_TRANSPARENT_WATER_MENUITEM);
 
     wxMenuItem* drawOnlyPointsMenuItem = new wxMenuItem(controlMenu, ID_DRAW_ONLY_POINTS_MENUITEM, _("Draw Only Points\tP"), _("Draw only points"), wxITEM_CHECK);
     controlMenu->Append(drawOnlyPointsMenuItem);
-    drawOnlyPointsMenuItem->Check(false);
+    drawOnlyPointsMenuItem->Check(mWorld->GetDrawOnlyPoints());
     this->Bind(
         wxEVT_MENU,
         [this](wxCommandEvent & event)
         {
-            this->mDrawOnlyPoints = event.IsChecked();
+            this->mWorld->SetDrawOnlyPoints(event.IsChecked());
         },
         ID_DRAW_ONLY_POINTS_MENUITEM);
 
+    wxMenuItem* gpuWaterMenuItem = new wxMenuItem(controlMenu, ID_GPU_WATER_MENUITEM, _("GPU Water\tG"), _("Calculate the water surface on the GPU"), wxITEM_CHECK);
+    controlMenu->Append(gpuWaterMenuItem);
+    gpuWaterMenuItem->Check(mWorld->GetUseGpuWater());
+    this->Bind(
+        wxEVT_MENU,
+        [this](wxCommandEvent & event)
+        {
+            this->mWorld->SetUseGpuWater(event.IsChecked());
+        },
+        ID_GPU_WATER_MENUITEM);
+
+    wxMenuItem* performanceOverlayMenuItem = new wxMenuItem(controlMenu, ID_PERFORMANCE_OVERLAY_MENUITEM, _("Performance Overlay\tO"), _("Show the frame times, pass times and counters in the canvas"), wxITEM_CHECK);
+    controlMenu->Append(performanceOverlayMenuItem);
+    performanceOverlayMenuItem->Check(true);
+    this->Bind(
+        wxEVT_MENU,
+        [this](wxCommandEvent & event)
+        {
+            if (!!this->mRenderContext)
+                this->mRenderContext->SetShowPerformanceOverlay(event.IsChecked());
+        },
+        ID_PERFORMANCE_OVERLAY_MENUITEM);
+
     mainMenuBar->Append(controlMenu, _("&Control"));
 
 
@@ -146,6 +182,27 @@ MainFrame::MainFrame()
 
 	wxMenu * fileMenu = new wxMenu();
 	
+    wxMenuItem* copyFrameStatisticsMenuItem = new wxMenuItem(fileMenu, ID_COPY_FRAME_STATISTICS_MENUITEM, _("Copy Frame Statistics\tCtrl-C"), _("Copy the frame time statistics to the clipboard, as JSON"), wxITEM_NORMAL);
+    fileMenu->Append(copyFrameStatisticsMenuItem);
+    Connect(ID_COPY_FRAME_STATISTICS_MENUITEM, wxEVT_COMMAND_MENU_SELECTED, (wxObjectEventFunction)&MainFrame::OnCopyFrameStatisticsMenuItemSelected);
+
+    wxMenuItem* copyMemoryReportMenuItem = new wxMenuItem(fileMenu, ID_COPY_MEMORY_REPORT_MENUITEM, _("Copy Memory Report\tCtrl-M"), _("Copy the current and peak memory of the render buffers and of the world to the clipboard"), wxITEM_NORMAL);
+    fileMenu->Append(copyMemoryReportMenuItem);
+    Connect(ID_COPY_MEMORY_REPORT_MENUITEM, wxEVT_COMMAND_MENU_SELECTED, (wxObjectEventFunction)&MainFrame::OnCopyMemoryReportMenuItemSelected);
+
+    wxMenuItem* recordRenderCommandsMenuItem = new wxMenuItem(fileMenu, ID_RECORD_RENDER_COMMANDS_MENUITEM, _("Record Render Commands...\tCtrl-R"), _("Record the render commands of the following frames to a file, for replaying with OpenGLTestBench"), wxITEM_CHECK);
+    fileMenu->Append(recordRenderCommandsMenuItem);
+    Connect(ID_RECORD_RENDER_COMMANDS_MENUITEM, wxEVT_COMMAND_MENU_SELECTED, (wxObjectEventFunction)&MainFrame::OnRecordRenderCommandsMenuItemSelected);
+
+    if (Profiler::IsCompiledIn)
+    {
+        wxMenuItem* saveProfileTraceMenuItem = new wxMenuItem(fileMenu, ID_SAVE_PROFILE_TRACE_MENUITEM, _("Save Profile Trace..."), _("Save the profiled scopes as a trace-event JSON file"), wxITEM_NORMAL);
+        fileMenu->Append(saveProfileTraceMenuItem);
+        Connect(ID_SAVE_PROFILE_TRACE_MENUITEM, wxEVT_COMMAND_MENU_SELECTED, (wxObjectEventFunction)&MainFrame::OnSaveProfileTraceMenuItemSelected);
+
+        fileMenu->AppendSeparator();
+    }
+
 	wxMenuItem* quitMenuItem = new wxMenuItem(fileMenu, ID_QUIT_MENUITEM, _("Quit\tAlt-F4"), _("Quit the application"), wxITEM_NORMAL);
 	fileMenu->Append(quitMenuItem);
 	Connect(ID_QUIT_MENUITEM, wxEVT_COMMAND_MENU_SELECTED, (wxObjectEventFunction)&MainFrame::OnQuit);
@@ -184,6 +241,10 @@ MainFrame::MainFrame()
         InitOpenGL();
 
         mRenderContext = std::unique_ptr<RenderContext>(new RenderContext());
+        mRenderContext->SetShowPerformanceOverlay(true);
+
+        // Start with the whole ship in view, however large
+        mRenderContext->SetZoom(mWorld->GetFittingZoom());
 
         //
         // Initialize timers
@@ -197,12 +258,6 @@ MainFrame::MainFrame()
         Connect(ID_STATS_REFRESH_TIMER, wxEVT_TIMER, (wxObjectEventFunction)&MainFrame::OnStatsRefreshTimerTrigger);
         mStatsRefreshTimer->Start(1000, false);
 
-
-        //
-        // Create world
-        //
-
-        CreateWorld();
     }
     catch (std::exception const & ex)
     {
@@ -286,6 +341,8 @@ void MainFrame::OnGameTimerTrigger(wxTimerEvent & /*event*/)
     // Make the timer for the next step start now
     mGameTimer->Start(0, true);
 
+    PROFILE_SCOPE("Frame");
+
     //
     // Calculate ambient light intensity
     //
@@ -299,140 +356,90 @@ void MainFrame::OnGameTimerTrigger(wxTimerEvent & /*event*/)
     //
 
     assert(nullptr != mRenderContext);
-    mRenderContext->RenderStart();
-
-    //
-    // Land
-    //
 
-    static constexpr int LeftLand = -140;
-    static constexpr int RightLand = 140;
-    static constexpr float SeaDepth = 60.0f;
-
-    mRenderContext->RenderLandStart(RightLand - LeftLand);
-
-    for (int i = LeftLand; i <= RightLand; ++i)
+    if (!!mRenderRecorder)
     {
-        mRenderContext->RenderLand(
-            static_cast<float>(i),
-            -SeaDepth,
-            GetOceanFloorHeight(static_cast<float>(i), SeaDepth));
-    }    
-    
-    mRenderContext->RenderLandEnd();
+        try
+        {
+            mWorld->Render(*mRenderRecorder);
+        }
+        catch (std::exception const & ex)
+        {
+            mRenderRecorder.reset();
+            GetMenuBar()->Check(ID_RECORD_RENDER_COMMANDS_MENUITEM, false);
 
-    if (mIsWaterTransparent)
+            wxMessageBox(ex.what(), "ERROR");
+        }
+    }
+    else
     {
-        RenderWater();
+        mWorld->Render(*mRenderContext);
     }
 
-    //
-    // Upload points
-    //
-
-    mRenderContext->UploadShipPointStart(WorldWidth * WorldHeight);
-
-    int currentIndex = 0;
-    for (int c = 0; c < WorldWidth; ++c)
     {
-        for (int r = 0; r < WorldHeight; ++r)
-        {
-            Point * a = &(mPoints[c][r]);
-            vec3f Colour = a->GetColour(mRenderContext->GetAmbientLightIntensity());
+        PROFILE_SCOPE("SwapBuffers");
 
-            mRenderContext->UploadShipPoint(
-                a->Position.x,
-                a->Position.y,
-                Colour.x,
-                Colour.y,
-                Colour.z);
+        mMainGLCanvas->SwapBuffers();
+    }
 
-            a->RenderIndex = currentIndex;
+    ++mFrameCount;
+    mFrameStatistics.OnFrame(std::chrono::steady_clock::now());
 
-            ++currentIndex;
-        }
-    }
+    mWorld->Update();
+}
 
-    mRenderContext->UploadShipPointEnd();
+void MainFrame::OnStatsRefreshTimerTrigger(wxTimerEvent & /*event*/)
+{
+	std::wostringstream ss;
+	ss << GetWindowTitle();
+	ss << "  FPS: " << mFrameCount << ", Points: " << mWorld->GetPointCount() << ", Triangles: " << mWorld->GetTriangleCount();
 
+    FrameStatistics::Summary const frameSummary = mFrameStatistics.GetSummary();
+    ss << std::fixed << std::setprecision(1)
+        << ", Frame ms p50/p95/p99/max: " << frameSummary.P50 << "/" << frameSummary.P95 << "/" << frameSummary.P99 << "/" << frameSummary.Max
+        << ", Hitches: " << frameSummary.Hitches << "/" << frameSummary.FrameCount
+        << std::defaultfloat << std::setprecision(6);
 
-    if (mDrawOnlyPoints)
-    {
-        mRenderContext->RenderShipPoints();
-    }
-    else
+    if (!!mRenderContext)
     {
-        //
-        // Springs
-        //
-
-        mRenderContext->RenderSpringsStart(mSprings.size());
+        StreamingBuffer::Statistics const & streamStats = mRenderContext->GetShipPointStreamStatistics();
+        ss << ", Streamed: " << (streamStats.BytesStreamed - mLastShipPointStreamStatistics.BytesStreamed) / 1024u << " KB/s"
+            << ", Stalls: " << (streamStats.Stalls - mLastShipPointStreamStatistics.Stalls);
 
-        for (Spring const & spring : mSprings)
+        if (mRenderContext->IsUsingVertexArrayObjects())
         {
-            mRenderContext->RenderSpring(
-                spring.PointA->RenderIndex,
-                spring.PointB->RenderIndex);
+            ss << ", Attrib Calls Saved: " << mRenderContext->GetAttributeSetupCallsSaved() << "/frame";
         }
 
-        mRenderContext->RenderSpringsEnd();
-
+        OpenGLStateTracker::Statistics const & stateStats = mRenderContext->GetStateChangeStatistics();
+        ss << ", State Changes: " << stateStats.Issued << " issued/" << stateStats.Elided << " elided per frame";
 
-        mRenderContext->RenderStressedSpringsStart(mSprings.size());
+        RenderContext::FrameCounters const & frameCounters = mRenderContext->GetLastFrameCounters();
+        ss << ", Draws: " << frameCounters.DrawCalls
+            << ", Programs: " << frameCounters.ProgramSwitches
+            << ", Uniforms: " << frameCounters.UniformUploads
+            << ", Attribs: " << frameCounters.AttributeSetups
+            << ", Uploaded: " << frameCounters.GetTotalBytesUploaded() / 1024u << " KB/frame";
 
-        for (Spring const & spring : mSprings)
+        if (mRenderContext->IsGpuTimingSupported())
         {
-            if (spring.IsStressed)
+            ss << ", GPU ms:";
+            for (size_t p = 0; p < static_cast<size_t>(RenderContext::RenderPass::_Count); ++p)
             {
-                mRenderContext->RenderStressedSpring(
-                    spring.PointA->RenderIndex,
-                    spring.PointB->RenderIndex);
+                RenderContext::RenderPass const pass = static_cast<RenderContext::RenderPass>(p);
+                ss << " " << RenderContext::GetRenderPassName(pass) << " " << mRenderContext->GetAverageGpuPassTime(pass);
             }
         }
 
-        mRenderContext->RenderStressedSpringsEnd();
-
-
-        //
-        // Triangles
-        //
-
-        mRenderContext->RenderShipTrianglesStart(mTriangles.size());
-
-        for (Triangle const & triangle : mTriangles)
-        {
-            mRenderContext->RenderShipTriangle(
-                triangle.PointA->RenderIndex,
-                triangle.PointB->RenderIndex,
-                triangle.PointC->RenderIndex);
-        }
-
-        mRenderContext->RenderShipTrianglesEnd();
+        mLastShipPointStreamStatistics = streamStats;
     }
 
-    if (!mIsWaterTransparent)
+    if (!!mRenderRecorder)
     {
-        RenderWater();
+        ss << ", Recording: " << mRenderRecorder->GetRecordedFrameCount() << " frames, "
+            << mRenderRecorder->GetRecordedBytes() / 1024u << " KB";
     }
 
-    //
-    // End
-    //
-
-    mRenderContext->RenderEnd();
-
-    mMainGLCanvas->SwapBuffers();
-
-    ++mFrameCount;
-    mCurrentTime += 0.2f;
-}
-
-void MainFrame::OnStatsRefreshTimerTrigger(wxTimerEvent & /*event*/)
-{
-	std::wostringstream ss;
-	ss << GetWindowTitle();
-	ss << "  FPS: " << mFrameCount << ", Triangles: " << mTriangles.size();
-
 	SetTitle(ss.str());
 
 	mFrameCount = 0u;
@@ -490,6 +497,123 @@ void MainFrame::OnMainGLCanvasMouseWheel(wxMouseEvent& event)
 // Menu event handlers
 //
 
+void MainFrame::OnCopyFrameStatisticsMenuItemSelected(wxCommandEvent & /*event*/)
+{
+    if (wxTheClipboard->Open())
+    {
+        wxTheClipboard->SetData(new wxTextDataObject(mFrameStatistics.GetSummary().ToJson()));
+        wxTheClipboard->Close();
+    }
+}
+
+void MainFrame::OnCopyMemoryReportMenuItemSelected(wxCommandEvent & /*event*/)
+{
+    assert(!!mRenderContext);
+    assert(!!mWorld);
+
+    std::string report;
+    char line[256];
+
+    snprintf(line, sizeof(line), "%-18s %12s %12s %8s %12s %12s %8s\n",
+        "Buffer", "Staging", "Peak", "Allocs", "GPU", "Peak", "Allocs");
+    report += line;
+
+    auto const appendBufferMemory = [&](char const * name, RenderContext::BufferMemory const & memory)
+    {
+        snprintf(line, sizeof(line), "%-18s %12zu %12zu %8llu %12zu %12zu %8llu\n",
+            name,
+            memory.StagingBytes,
+            memory.PeakStagingBytes,
+            static_cast<unsigned long long>(memory.StagingAllocations),
+            memory.GpuBytes,
+            memory.PeakGpuBytes,
+            static_cast<unsigned long long>(memory.GpuAllocations));
+        report += line;
+    };
+
+    for (size_t b = 0; b < static_cast<size_t>(RenderContext::BufferType::_Count); ++b)
+    {
+        RenderContext::BufferType const bufferType = static_cast<RenderContext::BufferType>(b);
+        appendBufferMemory(RenderContext::GetBufferTypeName(bufferType), mRenderContext->GetBufferMemory(bufferType));
+    }
+
+    appendBufferMemory("Total", mRenderContext->GetTotalBufferMemory());
+
+    World::MemoryUsage const worldMemoryUsage = mWorld->GetMemoryUsage();
+
+    snprintf(line, sizeof(line), "\nWorld: points %zu, springs %zu, triangles %zu, total %zu bytes\n",
+        worldMemoryUsage.PointBytes,
+        worldMemoryUsage.SpringBytes,
+        worldMemoryUsage.TriangleBytes,
+        worldMemoryUsage.GetTotalBytes());
+    report += line;
+
+    if (wxTheClipboard->Open())
+    {
+        wxTheClipboard->SetData(new wxTextDataObject(report));
+        wxTheClipboard->Close();
+    }
+}
+
+void MainFrame::OnRecordRenderCommandsMenuItemSelected(wxCommandEvent & event)
+{
+    if (!event.IsChecked())
+    {
+        // Closes the file
+        mRenderRecorder.reset();
+        return;
+    }
+
+    wxFileDialog saveFileDialog(
+        this,
+        _("Record Render Commands"),
+        wxEmptyString,
+        "OpenGLTest.rec",
+        "Render recordings (*.rec)|*.rec",
+        wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+
+    if (saveFileDialog.ShowModal() == wxID_CANCEL)
+    {
+        GetMenuBar()->Check(ID_RECORD_RENDER_COMMANDS_MENUITEM, false);
+        return;
+    }
+
+    try
+    {
+        assert(!!mRenderContext);
+        mRenderRecorder = std::make_unique<RenderRecorder>(*mRenderContext, saveFileDialog.GetPath().ToStdString());
+    }
+    catch (std::exception const & ex)
+    {
+        GetMenuBar()->Check(ID_RECORD_RENDER_COMMANDS_MENUITEM, false);
+
+        wxMessageBox(ex.what(), "ERROR");
+    }
+}
+
+void MainFrame::OnSaveProfileTraceMenuItemSelected(wxCommandEvent & /*event*/)
+{
+    wxFileDialog saveFileDialog(
+        this,
+        _("Save Profile Trace"),
+        wxEmptyString,
+        "OpenGLTest.trace.json",
+        "Trace files (*.json)|*.json",
+        wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+
+    if (saveFileDialog.ShowModal() == wxID_CANCEL)
+        return;
+
+    try
+    {
+        Profiler::WriteChromeTrace(saveFileDialog.GetPath().ToStdString());
+    }
+    catch (std::exception const & ex)
+    {
+        wxMessageBox(ex.what(), "ERROR");
+    }
+}
+
 void MainFrame::OnAboutMenuItemSelected(wxCommandEvent & /*event*/)
 {
 	wxMessageBox("Yeah!", L"OpenGLTest");
@@ -886,167 +1010,3 @@ void MainFrame::RenderCleanup()
 {
     glUseProgram(0);
 }
-
-void MainFrame::CreateWorld()
-{
-    // 
-    // Create points
-    //
-
-    for (int c = 0; c < WorldWidth; ++c)
-    {
-        float x = static_cast<float>(c) - static_cast<float>(WorldWidth) / 2.0f;
-
-        for (int r = 0; r < WorldHeight; ++r)
-        {            
-            float y = static_cast<float>(r) - static_cast<float>(WorldHeight) / 2.0f;
-
-            mPoints[c][r].Position = vec2f(x, y);
-
-            if (r == 0 || r == WorldHeight - 1 || c == 0 || c == WorldWidth - 1
-                || r == WorldHeight / 2 || c == WorldWidth / 2)
-            {
-                mPoints[c][r].Colour = vec3f(0.2f, 0.2f, 0.2f);
-            }
-            else if ((r == WorldHeight / 3 || r == WorldHeight * 2 / 3)
-                && (c >= WorldWidth / 3 && c <= WorldWidth * 2 / 3))
-            {
-                mPoints[c][r].Colour = vec3f(0.6f, 0.2f, 0.2f);
-            }
-            else if ((r >= WorldHeight / 3 && r <= WorldHeight * 2 / 3)
-                && (c == WorldWidth / 3 || c == WorldWidth * 2 / 3))
-            {
-                mPoints[c][r].Colour = vec3f(0.6f, 0.2f, 0.2f);
-            }
-            else
-            {
-                mPoints[c][r].Colour = vec3f(0.9f, 0.9f, 0.9f);
-            }
-
-
-            float distance = mPoints[c][r].Position.length();
-
-            if (distance > 20.0f && distance < 40.0f)
-            {
-                float d = (distance - 30.0f) / 10.0f; // -1 <= d <= 1
-                mPoints[c][r].Water = 1.0f - (d * d);
-            }
-            else
-            {
-                mPoints[c][r].Water = 0.0f;
-            }
-
-            if (distance == 0)
-            {
-                mPoints[c][r].Light = 1.0f;
-            }
-            else if (distance < 10.0f)
-            {
-                mPoints[c][r].Light = 1.0f / (distance * distance);
-            }
-            else
-            { 
-                mPoints[c][r].Light = 0.0f;
-            }
-        }
-    }
-
-
-    //
-    // Create springs and triangles
-    //
-
-    static const int Directions[8][2] = {
-        { 1,  0 },	// E
-        { 1, -1 },	// NE
-        { 0, -1 },	// N
-        { -1, -1 },	// NW
-        { -1,  0 },	// W
-        { -1,  1 },	// SW
-        { 0,  1 },	// S
-        { 1,  1 }	// SE
-    };
-
-    for (int c = 0; c < WorldWidth; ++c)
-    {
-        for (int r = 0; r < WorldHeight; ++r)
-        {
-            Point * pA = &(mPoints[c][r]);
-
-            for (int i = 0; i < 4; ++i)
-            {
-                int adjc1 = c + Directions[i][0];
-                int adjr1 = r + Directions[i][1];
-                
-                if (adjc1 >= 0 && adjc1 < WorldWidth && adjr1 >= 0)
-                {
-                    //
-                    // Create a<->b spring
-                    // 
-
-                    Point * pB = &(mPoints[adjc1][adjr1]);
-
-                    bool isStressed = (0 == (adjc1 % 10) && 0 == (adjr1 % 10));
-
-                    mSprings.emplace_back(pA, pB, isStressed);
-
-                    int adjc2 = c + Directions[i + 1][0];
-                    int adjr2 = r + Directions[i + 1][1];
-                    
-                    if (adjc2 >= 0 && adjc2 < WorldWidth && adjr2 >= 0)
-                    {
-                        if (adjc2 >= 20 && adjc2 < WorldWidth - 20 && adjr2 >= 20 && adjr2 < WorldHeight - 20)
-                        {
-                            //
-                            // Create a<->b<->c triangle
-                            //
-
-                            Point * pC = &(mPoints[adjc2][adjr2]);
-
-                            mTriangles.emplace_back(pA, pB, pC);
-                        }
-                    }
-                }
-            }
-        }
-    }
-}
-
-float MainFrame::GetOceanFloorHeight(float x, float seaDepth) const
-{
-    float const c1 = sinf(x * 0.05f) * 6.f;
-    float const c2 = sinf(x * 0.15f) * 2.f;
-    float const c3 = sin(x * 0.011f) * 25.f;
-    return -seaDepth + (c1 + c2 - c3) + 33.f;
-}
-
-float MainFrame::GetWaterHeight(float x, float waveHeight) const
-{
-    float const c1 = sinf(x * 0.1f + mCurrentTime) * 0.5f;
-    float const c2 = sinf(x * 0.3f - mCurrentTime * 1.1f) * 0.3f;
-    return (c1 + c2) * waveHeight;
-}
-
-void MainFrame::RenderWater()
-{
-    //
-    // Water
-    //
-
-    static constexpr int LeftWater = -140;
-    static constexpr int RightWater = 140;
-    static constexpr float WaveHeight = 2.0f;
-    static constexpr float SeaDepth = 60.0f;
-
-    mRenderContext->RenderWaterStart(RightWater - LeftWater);
-
-    for (int i = LeftWater; i <= RightWater; ++i)
-    {
-        mRenderContext->RenderWater(
-            static_cast<float>(i),
-            -SeaDepth,
-            GetWaterHeight(static_cast<float>(i), WaveHeight));
-    }
-
-    mRenderContext->RenderWaterEnd();
-}
\ No newline at end of file
@@ -1,6 +1,9 @@
+#include "FrameStatistics.h"
 #include "OpenGLTest.h"
 #include "RenderContext.h"
+#include "RenderRecorder.h"
 #include "Vectors.h"
+#include "World.h"
 
 #include <wx/filedlg.h>
 #include <wx/frame.h>
@@ -18,7 +21,9 @@ class MainFrame : public wxFrame
 {
 public:
 
-	MainFrame();
+	MainFrame(
+        int worldWidth,
+        int worldHeight);
 
 	virtual ~MainFrame();
 
@@ -62,6 +67,10 @@ private:
 	void OnMainGLCanvasMouseWheel(wxMouseEvent& event);
 
 	// Menu
+	void OnCopyFrameStatisticsMenuItemSelected(wxCommandEvent& event);
+	void OnCopyMemoryReportMenuItemSelected(wxCommandEvent& event);
+	void OnRecordRenderCommandsMenuItemSelected(wxCommandEvent& event);
+	void OnSaveProfileTraceMenuItemSelected(wxCommandEvent& event);
 	void OnAboutMenuItemSelected(wxCommandEvent& event);
 
 private:
@@ -76,75 +85,12 @@ private:
 
     std::unique_ptr<RenderContext> mRenderContext;
 
+    // Only while recording
+    std::unique_ptr<RenderRecorder> mRenderRecorder;
+
 private:
 
-    void CreateWorld();
-    float GetOceanFloorHeight(float x, float seaDepth) const;
-    float GetWaterHeight(float x, float waveHeight) const;
-    void RenderWater();
-
-    struct Point
-    {
-        vec2f Position;
-        vec3f Colour;
-        float Water;
-        float Light;
-
-        int RenderIndex;
-
-        vec3f GetColour(float ambientLightIntensity)
-        {
-            static constexpr vec3f LightPointColour = vec3f(1.0f, 1.0f, 0.25f);
-            static constexpr vec3f WetPointColour = vec3f(0.0f, 0.0f, 0.8f);
-
-            float const colorWetness = fminf(Water, 1.0f) * 0.7f;
-
-            vec3f colour1 = Colour * (1.0f - colorWetness)
-                + WetPointColour * colorWetness;
-
-            colour1 *= ambientLightIntensity;
-
-            float const colorLightness = Light;
-
-            return colour1 * (1.0f - colorLightness)
-                + LightPointColour * colorLightness;
-        }
-    };
-
-    struct Spring
-    {
-        Point * const PointA;
-        Point * const PointB;
-        bool IsStressed;
-
-        Spring(Point * a, Point * b, bool isStressed)
-            : PointA(a)
-            , PointB(b)
-            , IsStressed(isStressed)
-        {}
-    };
-
-    struct Triangle
-    {
-        Point * const PointA;
-        Point * const PointB;
-        Point * const PointC;
-
-        Triangle(Point * a, Point * b, Point * c)
-            : PointA(a)
-            , PointB(b)
-            , PointC(c)
-        {}
-    };
-
-    static constexpr int WorldWidth = 140;
-    static constexpr int WorldHeight = 110;
-    Point mPoints[WorldWidth][WorldHeight];
-    std::vector<Spring> mSprings;
-    std::vector<Triangle> mTriangles;
-
-    bool mIsWaterTransparent;
-    bool mDrawOnlyPoints;
+    std::unique_ptr<World> mWorld;
 
 private:
 
@@ -167,5 +113,8 @@ private:
 	MouseInfo mMouseInfo;
 
 	uint64_t mFrameCount;	
-    float mCurrentTime;
+
+    FrameStatistics mFrameStatistics;
+
+    StreamingBuffer::Statistics mLastShipPointStreamStatistics;
 };
@@ -0,0 +1,480 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "ShipIndexChunks.h"
+#include "Vectors.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/*
+ * A stand-in for RenderContext that needs no OpenGL context: elements are
+ * written into staging buffers just like RenderContext does, but they never
+ * reach a GL buffer, and draws do nothing. Likewise, the bulk uploads copy what
+ * RenderContext copies into its streams, and the topology gets narrowed to 16-bit
+ * indices whenever RenderContext would do so, or else copied as glBufferData would.
+ *
+ * Used to measure the CPU cost of the world's per-frame loops in isolation.
+ */
+class NullRenderContext
+{
+public:
+
+    NullRenderContext()
+        : mLandVersion(0u)
+        , mWaterSurfaceVersion(0u)
+        , mShipTopologyVersion(0u)
+        , mShipTopologyPointCount(0u)
+        , mShipIndexChunks()
+        , mShipIndices()
+        , mStressedSpringsVersion(0u)
+        , mAreShipPointPositionsDirty(true)
+        , mAreShipPointColoursDirty(true)
+        , mLandBuffer()
+        , mWaterBuffer()
+        , mWaterSurfaceBuffer()
+        , mShipPointPositionBuffer()
+        , mShipPointColourBuffer()
+        , mShipPointColourPlanesBuffer()
+        , mSpringBuffer()
+        , mShipTriangleBuffer()
+        , mStressedSpringBuffer()
+        , mElementCount(0u)
+    {}
+
+    NullRenderContext(NullRenderContext const & other) = delete;
+    NullRenderContext & operator=(NullRenderContext const & other) = delete;
+
+    /*
+     * The number of elements written since the last reset.
+     */
+    size_t GetElementCount() const
+    {
+        return mElementCount;
+    }
+
+    void ResetElementCount()
+    {
+        mElementCount = 0u;
+    }
+
+public:
+
+    void RenderStart()
+    {
+    }
+
+
+    //
+    // Land
+    //
+
+    uint64_t GetLandVersion() const
+    {
+        return mLandVersion;
+    }
+
+    void UploadLandStart(
+        uint64_t version,
+        size_t slices)
+    {
+        mLandVersion = version;
+        Start(mLandBuffer, slices + 1);
+    }
+
+    inline void UploadLand(
+        float x,
+        float bottom,
+        float top)
+    {
+        Write(mLandBuffer, Element4{ x, top, x, bottom });
+    }
+
+    void UploadLandEnd()
+    {
+    }
+
+    void RenderLand()
+    {
+    }
+
+
+    //
+    // Water
+    //
+
+    void RenderWaterStart(size_t slices)
+    {
+        Start(mWaterBuffer, slices + 1);
+    }
+
+    inline void RenderWater(
+        float x,
+        float bottom,
+        float top)
+    {
+        Write(mWaterBuffer, Element4{ x, top, x, bottom });
+    }
+
+    void RenderWaterEnd()
+    {
+    }
+
+
+    //
+    // Water surface
+    //
+
+    uint64_t GetWaterSurfaceVersion() const
+    {
+        return mWaterSurfaceVersion;
+    }
+
+    void UploadWaterSurfaceStart(
+        uint64_t version,
+        size_t slices)
+    {
+        mWaterSurfaceVersion = version;
+        Start(mWaterSurfaceBuffer, slices + 1);
+    }
+
+    inline void UploadWaterSurface(
+        float x,
+        float bottom)
+    {
+        Write(mWaterSurfaceBuffer, Element6{ x, 0.0f, 1.0f, x, bottom, 0.0f });
+    }
+
+    void UploadWaterSurfaceEnd()
+    {
+    }
+
+    void RenderWaterSurface(
+        float /*time*/,
+        float /*waveHeight*/)
+    {
+    }
+
+
+    //
+    // Ship Points
+    //
+
+    bool AreShipPointPositionsDirty() const
+    {
+        return mAreShipPointPositionsDirty;
+    }
+
+    void InvalidateShipPointPositions()
+    {
+        mAreShipPointPositionsDirty = true;
+    }
+
+    void UploadShipPointPositionsStart(size_t points)
+    {
+        Start(mShipPointPositionBuffer, points);
+    }
+
+    inline void UploadShipPointPosition(
+        float x,
+        float y)
+    {
+        Write(mShipPointPositionBuffer, Element2{ x, y });
+    }
+
+    void UploadShipPointPositionsEnd()
+    {
+        mAreShipPointPositionsDirty = false;
+    }
+
+    void UploadShipPointPositions(
+        vec2f const * positions,
+        size_t points)
+    {
+        Copy(mShipPointPositionBuffer, reinterpret_cast<Element2 const *>(positions), points);
+
+        mAreShipPointPositionsDirty = false;
+    }
+
+    bool AreShipPointColoursDirty() const
+    {
+        return mAreShipPointColoursDirty;
+    }
+
+    void InvalidateShipPointColours()
+    {
+        mAreShipPointColoursDirty = true;
+    }
+
+    void UploadShipPointColoursStart(size_t points)
+    {
+        Start(mShipPointColourBuffer, points);
+    }
+
+    inline void UploadShipPointColour(
+        float r,
+        float g,
+        float b,
+        float water,
+        float light)
+    {
+        Write(mShipPointColourBuffer, Element5{ r, g, b, water, light });
+    }
+
+    void UploadShipPointColoursEnd()
+    {
+        mAreShipPointColoursDirty = false;
+    }
+
+    void UploadShipPointColours(
+        vec3f const * colours,
+        float const * waters,
+        float const * lights,
+        size_t points)
+    {
+        // The planes, back to back, as in RenderContext's stream
+        Start(mShipPointColourPlanesBuffer, points * 5);
+        std::memcpy(mShipPointColourPlanesBuffer.Elements.data(), colours, points * sizeof(vec3f));
+        std::memcpy(mShipPointColourPlanesBuffer.Elements.data() + points * 3, waters, points * sizeof(float));
+        std::memcpy(mShipPointColourPlanesBuffer.Elements.data() + points * 4, lights, points * sizeof(float));
+        mElementCount += points;
+
+        mAreShipPointColoursDirty = false;
+    }
+
+    void RenderShipPoints()
+    {
+    }
+
+
+    //
+    // Ship topology
+    //
+
+    uint64_t GetShipTopologyVersion() const
+    {
+        return mShipTopologyVersion;
+    }
+
+    void UploadShipTopologyStart(
+        uint64_t version,
+        size_t points,
+        size_t springs,
+        size_t triangles)
+    {
+        mShipTopologyVersion = version;
+        mShipTopologyPointCount = points;
+        Start(mSpringBuffer, springs);
+        Start(mShipTriangleBuffer, triangles);
+    }
+
+    inline void UploadShipSpring(
+        int shipPointIndex1,
+        int shipPointIndex2)
+    {
+        Write(mSpringBuffer, Index2{ shipPointIndex1, shipPointIndex2 });
+    }
+
+    inline void UploadShipTriangle(
+        int shipPointIndex1,
+        int shipPointIndex2,
+        int shipPointIndex3)
+    {
+        Write(mShipTriangleBuffer, Index3{ shipPointIndex1, shipPointIndex2, shipPointIndex3 });
+    }
+
+    void UploadShipTopologyEnd()
+    {
+        NarrowShipIndices(reinterpret_cast<int const *>(mSpringBuffer.Elements.data()), mSpringBuffer.Size, 2);
+        NarrowShipIndices(reinterpret_cast<int const *>(mShipTriangleBuffer.Elements.data()), mShipTriangleBuffer.Size, 3);
+    }
+
+    void UploadShipTopology(
+        uint64_t version,
+        size_t points,
+        int const * springIndices,
+        size_t springs,
+        int const * triangleIndices,
+        size_t triangles)
+    {
+        mShipTopologyVersion = version;
+        mShipTopologyPointCount = points;
+
+        NarrowShipIndices(springIndices, springs, 2);
+        NarrowShipIndices(triangleIndices, triangles, 3);
+        mElementCount += springs + triangles;
+    }
+
+
+    //
+    // Springs
+    //
+
+    void RenderSprings()
+    {
+    }
+
+    uint64_t GetStressedSpringsVersion() const
+    {
+        return mStressedSpringsVersion;
+    }
+
+    void UploadStressedSprings(
+        uint64_t version,
+        int const * /*springIndices*/,
+        size_t springs)
+    {
+        mStressedSpringsVersion = version;
+        mElementCount += springs;
+    }
+
+    void UpdateStressedSprings(
+        int const * /*springIndices*/,
+        size_t /*springs*/,
+        size_t dirtyStart,
+        size_t dirtyEnd)
+    {
+        mElementCount += dirtyEnd - dirtyStart;
+    }
+
+    void RenderStressedSprings()
+    {
+    }
+
+    void RenderStressedSpringsStart(size_t maxSprings)
+    {
+        Start(mStressedSpringBuffer, maxSprings);
+    }
+
+    inline void RenderStressedSpring(
+        int shipPointIndex1,
+        int shipPointIndex2)
+    {
+        Write(mStressedSpringBuffer, Index2{ shipPointIndex1, shipPointIndex2 });
+    }
+
+    void RenderStressedSpringsEnd()
+    {
+        mStressedSpringsVersion = 0u;
+    }
+
+
+    //
+    // Ship triangles
+    //
+
+    void RenderShipTriangles()
+    {
+    }
+
+    void RenderEnd()
+    {
+    }
+
+private:
+
+    struct Element2 { float a, b; };
+    struct Element4 { float a, b, c, d; };
+    struct Element5 { float a, b, c, d, e; };
+    struct Element6 { float a, b, c, d, e, f; };
+    struct Index2 { int a, b; };
+    struct Index3 { int a, b, c; };
+
+    template<typename TElement>
+    struct StagingBuffer
+    {
+        std::vector<TElement> Elements;
+        size_t Size;
+
+        StagingBuffer()
+            : Elements()
+            , Size(0u)
+        {}
+    };
+
+    // As RenderContext does for ships with less than 64K points; 32-bit indices
+    // go to the GL as-is, which copies them
+    void NarrowShipIndices(
+        int const * indices,
+        size_t primitiveCount,
+        size_t indicesPerPrimitive)
+    {
+        if (mShipTopologyPointCount <= 0x10000u)
+        {
+            std::vector<uint16_t> chunkIndices;
+            MakeShipIndexChunks(indices, primitiveCount, indicesPerPrimitive, chunkIndices, mShipIndexChunks);
+        }
+        else
+        {
+            mShipIndices.assign(indices, indices + primitiveCount * indicesPerPrimitive);
+        }
+    }
+
+    template<typename TElement>
+    static void Start(
+        StagingBuffer<TElement> & buffer,
+        size_t maxElements)
+    {
+        // Only grows, like RenderContext's buffers do once they're large enough
+        if (buffer.Elements.size() < maxElements)
+            buffer.Elements.resize(maxElements);
+
+        buffer.Size = 0u;
+    }
+
+    template<typename TElement>
+    inline void Write(
+        StagingBuffer<TElement> & buffer,
+        TElement const & element)
+    {
+        assert(buffer.Size < buffer.Elements.size());
+
+        buffer.Elements[buffer.Size++] = element;
+        ++mElementCount;
+    }
+
+    template<typename TElement>
+    inline void Copy(
+        StagingBuffer<TElement> & buffer,
+        TElement const * elements,
+        size_t count)
+    {
+        Start(buffer, count);
+
+        std::copy(elements, elements + count, buffer.Elements.data());
+        buffer.Size = count;
+        mElementCount += count;
+    }
+
+private:
+
+    uint64_t mLandVersion;
+    uint64_t mWaterSurfaceVersion;
+    uint64_t mShipTopologyVersion;
+    size_t mShipTopologyPointCount;
+    std::vector<ShipIndexChunk> mShipIndexChunks;
+    std::vector<int> mShipIndices;
+    uint64_t mStressedSpringsVersion;
+    bool mAreShipPointPositionsDirty;
+    bool mAreShipPointColoursDirty;
+
+    StagingBuffer<Element4> mLandBuffer;
+    StagingBuffer<Element4> mWaterBuffer;
+    StagingBuffer<Element6> mWaterSurfaceBuffer;
+    StagingBuffer<Element2> mShipPointPositionBuffer;
+    StagingBuffer<Element5> mShipPointColourBuffer;
+    StagingBuffer<float> mShipPointColourPlanesBuffer;
+    StagingBuffer<Index2> mSpringBuffer;
+    StagingBuffer<Index3> mShipTriangleBuffer;
+    StagingBuffer<Index2> mStressedSpringBuffer;
+
+    size_t mElementCount;
+};
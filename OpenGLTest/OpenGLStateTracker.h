@@ -0,0 +1,261 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "OpenGLTest.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+/*
+ * A shadow copy of the OpenGL state that we change during rendering; calls
+ * that would not change anything are not issued.
+ *
+ * All state starts out unknown, hence the first call for each piece of state
+ * is always issued. Whoever changes the state behind the tracker's back must
+ * tell the tracker about it, by means of the Invalidate*() methods.
+ */
+class OpenGLStateTracker
+{
+public:
+
+    struct Statistics
+    {
+        uint64_t Issued;
+        uint64_t Elided;
+
+        // Among the issued ones
+        uint64_t ProgramSwitches;
+
+        Statistics()
+            : Issued(0u)
+            , Elided(0u)
+            , ProgramSwitches(0u)
+        {}
+    };
+
+public:
+
+    OpenGLStateTracker()
+        : mProgram(UnknownName)
+        , mArrayBuffer(UnknownName)
+        , mElementArrayBuffer(UnknownName)
+        , mVertexArray(UnknownName)
+        , mCapabilities()
+        , mCapabilityCount(0u)
+        , mBlendSrcFactor(UnknownEnum)
+        , mBlendDstFactor(UnknownEnum)
+        , mLineWidth(-1.0f)
+        , mPointSize(-1.0f)
+        , mStatistics()
+    {}
+
+    OpenGLStateTracker(OpenGLStateTracker const & other) = delete;
+    OpenGLStateTracker & operator=(OpenGLStateTracker const & other) = delete;
+
+    inline void UseProgram(GLuint program)
+    {
+        if (program != mProgram)
+        {
+            glUseProgram(program);
+            mProgram = program;
+            ++mStatistics.Issued;
+            ++mStatistics.ProgramSwitches;
+        }
+        else
+        {
+            ++mStatistics.Elided;
+        }
+    }
+
+    inline void BindArrayBuffer(GLuint buffer)
+    {
+        if (buffer != mArrayBuffer)
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, buffer);
+            mArrayBuffer = buffer;
+            ++mStatistics.Issued;
+        }
+        else
+        {
+            ++mStatistics.Elided;
+        }
+    }
+
+    /*
+     * Note: the element array buffer binding is part of the vertex array object state.
+     */
+    inline void BindElementArrayBuffer(GLuint buffer)
+    {
+        if (buffer != mElementArrayBuffer)
+        {
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer);
+            mElementArrayBuffer = buffer;
+            ++mStatistics.Issued;
+        }
+        else
+        {
+            ++mStatistics.Elided;
+        }
+    }
+
+    inline void BindVertexArray(GLuint vertexArray)
+    {
+        if (vertexArray != mVertexArray)
+        {
+            glBindVertexArray(vertexArray);
+            mVertexArray = vertexArray;
+            ++mStatistics.Issued;
+
+            // We don't know which element array buffer the new VAO has
+            mElementArrayBuffer = UnknownName;
+        }
+        else
+        {
+            ++mStatistics.Elided;
+        }
+    }
+
+    inline void SetCapability(
+        GLenum capability,
+        bool isEnabled)
+    {
+        CapabilityState const newState = isEnabled ? CapabilityState::Enabled : CapabilityState::Disabled;
+
+        CapabilityState & currentState = GetCapabilityState(capability);
+        if (newState != currentState)
+        {
+            if (isEnabled)
+                glEnable(capability);
+            else
+                glDisable(capability);
+
+            currentState = newState;
+            ++mStatistics.Issued;
+        }
+        else
+        {
+            ++mStatistics.Elided;
+        }
+    }
+
+    inline void SetBlendFunc(
+        GLenum srcFactor,
+        GLenum dstFactor)
+    {
+        if (srcFactor != mBlendSrcFactor || dstFactor != mBlendDstFactor)
+        {
+            glBlendFunc(srcFactor, dstFactor);
+            mBlendSrcFactor = srcFactor;
+            mBlendDstFactor = dstFactor;
+            ++mStatistics.Issued;
+        }
+        else
+        {
+            ++mStatistics.Elided;
+        }
+    }
+
+    inline void SetLineWidth(float lineWidth)
+    {
+        if (lineWidth != mLineWidth)
+        {
+            glLineWidth(lineWidth);
+            mLineWidth = lineWidth;
+            ++mStatistics.Issued;
+        }
+        else
+        {
+            ++mStatistics.Elided;
+        }
+    }
+
+    inline void SetPointSize(float pointSize)
+    {
+        if (pointSize != mPointSize)
+        {
+            glPointSize(pointSize);
+            mPointSize = pointSize;
+            ++mStatistics.Issued;
+        }
+        else
+        {
+            ++mStatistics.Elided;
+        }
+    }
+
+    /*
+     * To be invoked after binding GL_ARRAY_BUFFER without going through the tracker.
+     */
+    void InvalidateArrayBuffer()
+    {
+        mArrayBuffer = UnknownName;
+    }
+
+    Statistics const & GetStatistics() const
+    {
+        return mStatistics;
+    }
+
+    void ResetStatistics()
+    {
+        mStatistics = Statistics();
+    }
+
+private:
+
+    enum class CapabilityState
+    {
+        Unknown,
+        Disabled,
+        Enabled
+    };
+
+    struct Capability
+    {
+        GLenum Name;
+        CapabilityState State;
+    };
+
+    inline CapabilityState & GetCapabilityState(GLenum capability)
+    {
+        // We only ever touch a handful of capabilities, so a linear search is as good as it gets
+        for (size_t c = 0; c < mCapabilityCount; ++c)
+        {
+            if (mCapabilities[c].Name == capability)
+                return mCapabilities[c].State;
+        }
+
+        assert(mCapabilityCount < MaxCapabilities);
+        mCapabilities[mCapabilityCount].Name = capability;
+        mCapabilities[mCapabilityCount].State = CapabilityState::Unknown;
+        return mCapabilities[mCapabilityCount++].State;
+    }
+
+private:
+
+    static constexpr GLuint UnknownName = std::numeric_limits<GLuint>::max();
+    static constexpr GLenum UnknownEnum = std::numeric_limits<GLenum>::max();
+    static constexpr size_t MaxCapabilities = 8;
+
+    GLuint mProgram;
+    GLuint mArrayBuffer;
+    GLuint mElementArrayBuffer;
+    GLuint mVertexArray;
+
+    Capability mCapabilities[MaxCapabilities];
+    size_t mCapabilityCount;
+
+    GLenum mBlendSrcFactor;
+    GLenum mBlendDstFactor;
+
+    float mLineWidth;
+    float mPointSize;
+
+    Statistics mStatistics;
+};
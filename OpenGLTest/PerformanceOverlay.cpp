@@ -0,0 +1,310 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "PerformanceOverlay.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace /* anonymous */ {
+
+    //
+    // The font: 3x5 glyphs for ASCII 32 (space) to 95 (underscore), five rows
+    // of three bits each, top row first and leftmost pixel in the highest bit
+    //
+
+    constexpr int FirstGlyph = 32;
+    constexpr int GlyphCount = 64;
+
+    constexpr uint16_t Glyphs[GlyphCount] = {
+        0b000'000'000'000'000, // space
+        0b010'010'010'000'010, // !
+        0b101'101'000'000'000, // "
+        0b101'111'101'111'101, // #
+        0b011'110'010'011'110, // $
+        0b101'001'010'100'101, // %
+        0b010'101'010'101'011, // &
+        0b010'010'000'000'000, // '
+        0b001'010'010'010'001, // (
+        0b100'010'010'010'100, // )
+        0b000'101'010'101'000, // *
+        0b000'010'111'010'000, // +
+        0b000'000'000'010'100, // ,
+        0b000'000'111'000'000, // -
+        0b000'000'000'000'010, // .
+        0b001'001'010'100'100, // /
+        0b111'101'101'101'111, // 0
+        0b010'110'010'010'111, // 1
+        0b111'001'111'100'111, // 2
+        0b111'001'111'001'111, // 3
+        0b101'101'111'001'001, // 4
+        0b111'100'111'001'111, // 5
+        0b111'100'111'101'111, // 6
+        0b111'001'001'001'001, // 7
+        0b111'101'111'101'111, // 8
+        0b111'101'111'001'111, // 9
+        0b000'010'000'010'000, // :
+        0b000'010'000'010'100, // ;
+        0b001'010'100'010'001, // <
+        0b000'111'000'111'000, // =
+        0b100'010'001'010'100, // >
+        0b111'001'010'000'010, // ?
+        0b111'101'111'100'111, // @
+        0b010'101'111'101'101, // A
+        0b110'101'110'101'110, // B
+        0b011'100'100'100'011, // C
+        0b110'101'101'101'110, // D
+        0b111'100'110'100'111, // E
+        0b111'100'110'100'100, // F
+        0b011'100'101'101'011, // G
+        0b101'101'111'101'101, // H
+        0b111'010'010'010'111, // I
+        0b001'001'001'101'010, // J
+        0b101'101'110'101'101, // K
+        0b100'100'100'100'111, // L
+        0b101'111'111'101'101, // M
+        0b110'101'101'101'101, // N
+        0b010'101'101'101'010, // O
+        0b110'101'110'100'100, // P
+        0b010'101'101'110'011, // Q
+        0b110'101'110'101'101, // R
+        0b011'100'010'001'110, // S
+        0b111'010'010'010'010, // T
+        0b101'101'101'101'111, // U
+        0b101'101'101'101'010, // V
+        0b101'101'111'111'101, // W
+        0b101'101'010'101'101, // X
+        0b101'101'010'010'010, // Y
+        0b111'001'010'100'111, // Z
+        0b011'010'010'010'011, // [
+        0b100'100'010'001'001, // backslash
+        0b110'010'010'010'110, // ]
+        0b010'101'000'000'000, // ^
+        0b000'000'000'000'111, // _
+    };
+
+    constexpr int GlyphWidth = 3;
+    constexpr int GlyphHeight = 5;
+
+    // Each glyph sits in the top-left corner of its cell in the texture, which
+    // keeps a blank column and row around it
+    constexpr int CellWidth = GlyphWidth + 1;
+    constexpr int CellHeight = GlyphHeight + 1;
+    constexpr int CellsPerRow = PerformanceOverlay::FontTextureWidth / CellWidth;
+
+    // Below the glyphs the texture is solid
+    constexpr int SolidAreaTop = (GlyphCount / CellsPerRow) * CellHeight;
+
+    static_assert(SolidAreaTop + 2 <= PerformanceOverlay::FontTextureHeight, "The font does not fit its texture");
+
+    //
+    // Layout, in pixels
+    //
+
+    constexpr float PixelScale = 2.0f;
+    constexpr float CharacterWidth = CellWidth * PixelScale;
+    constexpr float CharacterHeight = (CellHeight + 1) * PixelScale;
+    constexpr float Margin = 8.0f;
+    constexpr float Padding = 6.0f;
+    constexpr float GraphBarWidth = 2.0f;
+    constexpr float GraphHeight = 60.0f;
+
+    constexpr uint32_t PanelColour = 0x000000b0u;
+    constexpr uint32_t GraphBarColour = 0x40e040ffu;
+    constexpr uint32_t GraphHitchBarColour = 0xff4040ffu;
+    constexpr uint32_t GraphBudgetColour = 0xffffff80u;
+}
+
+std::vector<uint8_t> PerformanceOverlay::MakeFontTexture()
+{
+    std::vector<uint8_t> texels(FontTextureWidth * FontTextureHeight, 0u);
+
+    for (int g = 0; g < GlyphCount; ++g)
+    {
+        int const cellLeft = (g % CellsPerRow) * CellWidth;
+        int const cellTop = (g / CellsPerRow) * CellHeight;
+
+        for (int y = 0; y < GlyphHeight; ++y)
+        {
+            for (int x = 0; x < GlyphWidth; ++x)
+            {
+                int const bit = (GlyphHeight - 1 - y) * GlyphWidth + (GlyphWidth - 1 - x);
+                if (0 != (Glyphs[g] & (1 << bit)))
+                {
+                    texels[(cellTop + y) * FontTextureWidth + cellLeft + x] = 0xffu;
+                }
+            }
+        }
+    }
+
+    std::fill(texels.begin() + SolidAreaTop * FontTextureWidth, texels.end(), uint8_t(0xffu));
+
+    return texels;
+}
+
+PerformanceOverlay::PerformanceOverlay()
+    : mFrameTimes(GraphSampleCount, 0.0f)
+    , mNextFrameTime(0u)
+    , mFrameTimeBudget(1000.0f / 60.0f)
+    , mTextVertices()
+    , mTextColumns(0u)
+    , mTextRows(0u)
+    , mVertices()
+{
+}
+
+void PerformanceOverlay::AddFrameTime(float milliseconds)
+{
+    mFrameTimes[mNextFrameTime] = milliseconds;
+    mNextFrameTime = (mNextFrameTime + 1) % GraphSampleCount;
+}
+
+void PerformanceOverlay::ClearText()
+{
+    mTextVertices.clear();
+    mTextColumns = 0u;
+    mTextRows = 0u;
+}
+
+void PerformanceOverlay::AddText(
+    size_t column,
+    size_t row,
+    char const * text,
+    uint32_t colour)
+{
+    float const top = Margin + Padding + static_cast<float>(row) * CharacterHeight;
+
+    size_t c = column;
+    for (; *text != '\0'; ++text, ++c)
+    {
+        int character = static_cast<unsigned char>(*text);
+        if (character >= 'a' && character <= 'z')
+            character -= 'a' - 'A';
+
+        int const g = character - FirstGlyph;
+        if (g <= 0 || g >= GlyphCount)
+            continue;
+
+        float const left = Margin + Padding + static_cast<float>(c) * CharacterWidth;
+
+        float const uLeft = static_cast<float>((g % CellsPerRow) * CellWidth) / FontTextureWidth;
+        float const vTop = static_cast<float>((g / CellsPerRow) * CellHeight) / FontTextureHeight;
+
+        AddQuad(
+            left,
+            top,
+            left + GlyphWidth * PixelScale,
+            top + GlyphHeight * PixelScale,
+            uLeft,
+            vTop,
+            uLeft + static_cast<float>(GlyphWidth) / FontTextureWidth,
+            vTop + static_cast<float>(GlyphHeight) / FontTextureHeight,
+            colour,
+            mTextVertices);
+    }
+
+    mTextColumns = std::max(mTextColumns, c);
+    mTextRows = std::max(mTextRows, row + 1);
+}
+
+std::vector<PerformanceOverlay::Vertex> const & PerformanceOverlay::BuildVertices()
+{
+    mVertices.clear();
+
+    float const graphWidth = GraphSampleCount * GraphBarWidth;
+    float const textWidth = static_cast<float>(mTextColumns) * CharacterWidth;
+    float const textHeight = static_cast<float>(mTextRows) * CharacterHeight;
+
+    //
+    // Panel
+    //
+
+    float const panelRight = Margin + Padding + std::max(textWidth, graphWidth) + Padding;
+    float const graphTop = Margin + Padding + textHeight + Padding;
+    float const graphBottom = graphTop + GraphHeight;
+
+    AddSolidQuad(Margin, Margin, panelRight, graphBottom + Padding, PanelColour, mVertices);
+
+    //
+    // Graph, oldest sample first; the scale fits twice the budget
+    //
+
+    float const graphLeft = Margin + Padding;
+    float const pixelsPerMillisecond = GraphHeight / (2.0f * mFrameTimeBudget);
+
+    for (size_t s = 0; s < GraphSampleCount; ++s)
+    {
+        float const frameTime = mFrameTimes[(mNextFrameTime + s) % GraphSampleCount];
+        if (frameTime <= 0.0f)
+            continue;
+
+        float const barHeight = std::min(frameTime * pixelsPerMillisecond, GraphHeight);
+        float const barLeft = graphLeft + static_cast<float>(s) * GraphBarWidth;
+
+        AddSolidQuad(
+            barLeft,
+            graphBottom - barHeight,
+            barLeft + GraphBarWidth,
+            graphBottom,
+            frameTime > mFrameTimeBudget ? GraphHitchBarColour : GraphBarColour,
+            mVertices);
+    }
+
+    float const budgetY = graphBottom - mFrameTimeBudget * pixelsPerMillisecond;
+    AddSolidQuad(graphLeft, budgetY, graphLeft + graphWidth, budgetY + 1.0f, GraphBudgetColour, mVertices);
+
+    //
+    // Text, last so that it's on top
+    //
+
+    mVertices.insert(mVertices.end(), mTextVertices.begin(), mTextVertices.end());
+
+    return mVertices;
+}
+
+void PerformanceOverlay::AddQuad(
+    float left,
+    float top,
+    float right,
+    float bottom,
+    float uLeft,
+    float vTop,
+    float uRight,
+    float vBottom,
+    uint32_t colour,
+    std::vector<Vertex> & vertices)
+{
+    uint8_t const r = static_cast<uint8_t>(colour >> 24);
+    uint8_t const g = static_cast<uint8_t>(colour >> 16);
+    uint8_t const b = static_cast<uint8_t>(colour >> 8);
+    uint8_t const a = static_cast<uint8_t>(colour);
+
+    Vertex const topLeft{ left, top, uLeft, vTop, r, g, b, a };
+    Vertex const topRight{ right, top, uRight, vTop, r, g, b, a };
+    Vertex const bottomLeft{ left, bottom, uLeft, vBottom, r, g, b, a };
+    Vertex const bottomRight{ right, bottom, uRight, vBottom, r, g, b, a };
+
+    vertices.push_back(topLeft);
+    vertices.push_back(bottomLeft);
+    vertices.push_back(topRight);
+    vertices.push_back(topRight);
+    vertices.push_back(bottomLeft);
+    vertices.push_back(bottomRight);
+}
+
+void PerformanceOverlay::AddSolidQuad(
+    float left,
+    float top,
+    float right,
+    float bottom,
+    uint32_t colour,
+    std::vector<Vertex> & vertices)
+{
+    // Anywhere inside the solid area
+    float const u = 0.5f;
+    float const v = (static_cast<float>(SolidAreaTop) + 1.0f) / FontTextureHeight;
+
+    AddQuad(left, top, right, bottom, u, v, u, v, colour, vertices);
+}
@@ -0,0 +1,120 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+ * The geometry of the performance overlay: a translucent panel with lines of
+ * text in a tiny built-in bitmap font, above a graph of the most recent frame
+ * times.
+ *
+ * Everything - panel, graph bars and glyphs - is a textured quad sampling the
+ * same font texture, the untextured ones from its solid area, so that the whole
+ * overlay is drawn with a single draw call. Coordinates are in pixels from the
+ * top-left corner of the canvas.
+ *
+ * This class only builds the vertices; RenderContext owns the GL objects.
+ */
+class PerformanceOverlay
+{
+public:
+
+#pragma pack(push, 1)
+    struct Vertex
+    {
+        float x;
+        float y;
+        float u;
+        float v;
+        uint8_t r;
+        uint8_t g;
+        uint8_t b;
+        uint8_t a;
+    };
+#pragma pack(pop)
+
+    // The font texture, GL_ALPHA, one byte per texel
+    static constexpr int FontTextureWidth = 64;
+    static constexpr int FontTextureHeight = 32;
+
+    static std::vector<uint8_t> MakeFontTexture();
+
+    // Colours are 0xRRGGBBAA
+    static constexpr uint32_t TextColour = 0xffffffffu;
+    static constexpr uint32_t HeaderColour = 0xffd040ffu;
+
+public:
+
+    PerformanceOverlay();
+
+    /*
+     * Adds a sample to the frame time graph; the graph shows the most recent
+     * samples, against a line at the budget.
+     */
+    void AddFrameTime(float milliseconds);
+
+    void SetFrameTimeBudget(float milliseconds)
+    {
+        mFrameTimeBudget = milliseconds;
+    }
+
+    void ClearText();
+
+    /*
+     * Adds text at the specified character cell; lowercase letters are shown
+     * uppercase, and characters the font lacks as blanks.
+     */
+    void AddText(
+        size_t column,
+        size_t row,
+        char const * text,
+        uint32_t colour = TextColour);
+
+    /*
+     * The vertices - as triangles - of the panel, the graph and the text added
+     * since the last ClearText().
+     */
+    std::vector<Vertex> const & BuildVertices();
+
+private:
+
+    void AddQuad(
+        float left,
+        float top,
+        float right,
+        float bottom,
+        float uLeft,
+        float vTop,
+        float uRight,
+        float vBottom,
+        uint32_t colour,
+        std::vector<Vertex> & vertices);
+
+    void AddSolidQuad(
+        float left,
+        float top,
+        float right,
+        float bottom,
+        uint32_t colour,
+        std::vector<Vertex> & vertices);
+
+private:
+
+    static constexpr size_t GraphSampleCount = 120;
+
+    std::vector<float> mFrameTimes;
+    size_t mNextFrameTime;
+    float mFrameTimeBudget;
+
+    std::vector<Vertex> mTextVertices;
+    size_t mTextColumns;
+    size_t mTextRows;
+
+    std::vector<Vertex> mVertices;
+};
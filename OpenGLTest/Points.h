@@ -0,0 +1,108 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "AlignedBuffer.h"
+#include "Vectors.h"
+
+#include <cstddef>
+
+/*
+ * The ship points, as a structure of arrays: each attribute lives in its own
+ * contiguous, 64-byte-aligned array, so that a loop needing one attribute only
+ * streams that attribute through the cache.
+ *
+ * A point is identified by its index in the arrays, which is also its index in
+ * the render context's point buffers.
+ */
+class Points
+{
+public:
+
+    explicit Points(size_t count)
+        : mCount(count)
+        , mPositionBuffer(count)
+        , mColourBuffer(count)
+        , mWaterBuffer(count)
+        , mLightBuffer(count)
+    {}
+
+    Points(Points const & other) = delete;
+    Points & operator=(Points const & other) = delete;
+
+    size_t GetCount() const
+    {
+        return mCount;
+    }
+
+    /*
+     * The bytes allocated for all of the attributes.
+     */
+    size_t GetAllocationSize() const
+    {
+        return mPositionBuffer.GetAllocationSize()
+            + mColourBuffer.GetAllocationSize()
+            + mWaterBuffer.GetAllocationSize()
+            + mLightBuffer.GetAllocationSize();
+    }
+
+    //
+    // Single points
+    //
+
+    vec2f & GetPosition(size_t pointIndex)
+    {
+        return mPositionBuffer[pointIndex];
+    }
+
+    vec3f & GetColour(size_t pointIndex)
+    {
+        return mColourBuffer[pointIndex];
+    }
+
+    float & GetWater(size_t pointIndex)
+    {
+        return mWaterBuffer[pointIndex];
+    }
+
+    float & GetLight(size_t pointIndex)
+    {
+        return mLightBuffer[pointIndex];
+    }
+
+    //
+    // Whole attributes, for linear scans
+    //
+
+    vec2f const * GetPositionBuffer() const
+    {
+        return mPositionBuffer.data();
+    }
+
+    vec3f const * GetColourBuffer() const
+    {
+        return mColourBuffer.data();
+    }
+
+    float const * GetWaterBuffer() const
+    {
+        return mWaterBuffer.data();
+    }
+
+    float const * GetLightBuffer() const
+    {
+        return mLightBuffer.data();
+    }
+
+private:
+
+    size_t const mCount;
+
+    AlignedBuffer<vec2f> mPositionBuffer;
+    AlignedBuffer<vec3f> mColourBuffer;
+    AlignedBuffer<float> mWaterBuffer;
+    AlignedBuffer<float> mLightBuffer;
+};
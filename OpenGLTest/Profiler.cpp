@@ -0,0 +1,207 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "Profiler.h"
+
+#include "GameException.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace /* anonymous */ {
+
+    struct Event
+    {
+        char const * Name;
+        int64_t StartTime;
+        int64_t EndTime;
+    };
+
+    struct ThreadBuffer
+    {
+        static constexpr size_t Capacity = 64 * 1024;
+
+        std::unique_ptr<Event[]> Events;
+
+        // Total number of events ever recorded; only written by the owning thread
+        std::atomic<uint64_t> EventCount;
+
+        size_t const ThreadIndex;
+
+        explicit ThreadBuffer(size_t threadIndex)
+            : Events(new Event[Capacity])
+            , EventCount(0u)
+            , ThreadIndex(threadIndex)
+        {}
+    };
+
+    // The buffers outlive their threads, so that their events may still be dumped
+    struct ThreadBufferRegistry
+    {
+        std::mutex Mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> Buffers;
+    };
+
+    ThreadBufferRegistry & GetRegistry()
+    {
+        static ThreadBufferRegistry registry;
+        return registry;
+    }
+
+    ThreadBuffer & GetThreadBuffer()
+    {
+        thread_local ThreadBuffer * threadBuffer = nullptr;
+
+        if (nullptr == threadBuffer)
+        {
+            ThreadBufferRegistry & registry = GetRegistry();
+            std::lock_guard<std::mutex> lock(registry.Mutex);
+
+            registry.Buffers.emplace_back(std::make_unique<ThreadBuffer>(registry.Buffers.size() + 1));
+            threadBuffer = registry.Buffers.back().get();
+        }
+
+        return *threadBuffer;
+    }
+
+    std::chrono::steady_clock::time_point const Epoch = std::chrono::steady_clock::now();
+
+    void WriteJsonString(
+        FILE * file,
+        char const * str)
+    {
+        fputc('"', file);
+        for (; *str != '\0'; ++str)
+        {
+            if (*str == '"' || *str == '\\')
+                fputc('\\', file);
+
+            fputc(*str, file);
+        }
+        fputc('"', file);
+    }
+}
+
+int64_t Profiler::Now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Epoch).count();
+}
+
+void Profiler::RecordEvent(
+    char const * name,
+    int64_t startTime,
+    int64_t endTime)
+{
+    ThreadBuffer & threadBuffer = GetThreadBuffer();
+
+    uint64_t const eventCount = threadBuffer.EventCount.load(std::memory_order_relaxed);
+
+    Event & event = threadBuffer.Events[eventCount % ThreadBuffer::Capacity];
+    event.Name = name;
+    event.StartTime = startTime;
+    event.EndTime = endTime;
+
+    threadBuffer.EventCount.store(eventCount + 1, std::memory_order_release);
+}
+
+void Profiler::WriteChromeTrace(std::string const & filePath)
+{
+    FILE * file = fopen(filePath.c_str(), "w");
+    if (nullptr == file)
+    {
+        throw GameException("Cannot open trace file \"" + filePath + "\" for writing");
+    }
+
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+    bool isFirstEvent = true;
+
+    {
+        ThreadBufferRegistry & registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.Mutex);
+
+        for (auto const & threadBuffer : registry.Buffers)
+        {
+            uint64_t const eventCount = threadBuffer->EventCount.load(std::memory_order_acquire);
+            uint64_t const firstEvent = (eventCount > ThreadBuffer::Capacity) ? eventCount - ThreadBuffer::Capacity : 0u;
+
+            for (uint64_t e = firstEvent; e < eventCount; ++e)
+            {
+                Event const & event = threadBuffer->Events[e % ThreadBuffer::Capacity];
+
+                fprintf(file, isFirstEvent ? "{\"name\":" : ",\n{\"name\":");
+                WriteJsonString(file, event.Name);
+                fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%zu,\"ts\":%.3f,\"dur\":%.3f}",
+                    threadBuffer->ThreadIndex,
+                    static_cast<double>(event.StartTime) / 1000.0,
+                    static_cast<double>(event.EndTime - event.StartTime) / 1000.0);
+
+                isFirstEvent = false;
+            }
+        }
+    }
+
+    fprintf(file, "\n]}\n");
+
+    bool const hasFailed = (0 != ferror(file));
+    fclose(file);
+
+    if (hasFailed)
+    {
+        throw GameException("Error writing trace file \"" + filePath + "\"");
+    }
+}
+
+std::vector<Profiler::ScopeTime> Profiler::GetScopeTimes(int64_t sinceTime)
+{
+    std::vector<ScopeTime> scopeTimes;
+
+    {
+        ThreadBufferRegistry & registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.Mutex);
+
+        for (auto const & threadBuffer : registry.Buffers)
+        {
+            uint64_t const eventCount = threadBuffer->EventCount.load(std::memory_order_acquire);
+            uint64_t const firstEvent = (eventCount > ThreadBuffer::Capacity) ? eventCount - ThreadBuffer::Capacity : 0u;
+
+            for (uint64_t e = firstEvent; e < eventCount; ++e)
+            {
+                Event const & event = threadBuffer->Events[e % ThreadBuffer::Capacity];
+                if (event.StartTime < sinceTime)
+                    continue;
+
+                // Names are compared by content, as the same literal may have different
+                // addresses in different translation units
+                auto it = std::find_if(
+                    scopeTimes.begin(),
+                    scopeTimes.end(),
+                    [&event](ScopeTime const & scopeTime) { return 0 == strcmp(scopeTime.Name, event.Name); });
+
+                if (it == scopeTimes.end())
+                {
+                    scopeTimes.push_back({ event.Name, 0u, 0 });
+                    it = scopeTimes.end() - 1;
+                }
+
+                ++(it->Count);
+                it->TotalTime += event.EndTime - event.StartTime;
+            }
+        }
+    }
+
+    std::sort(
+        scopeTimes.begin(),
+        scopeTimes.end(),
+        [](ScopeTime const & a, ScopeTime const & b) { return strcmp(a.Name, b.Name) < 0; });
+
+    return scopeTimes;
+}
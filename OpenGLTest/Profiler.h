@@ -0,0 +1,97 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+ * A scoped CPU profiler: each PROFILE_SCOPE records the time from where it appears
+ * to the end of the enclosing scope, under a name that must be a string literal.
+ *
+ * Events go to a buffer owned by the calling thread; the buffer is allocated on the
+ * thread's first event, and from then on recording neither allocates nor locks. Each
+ * buffer is a ring holding the thread's most recent events.
+ *
+ * The events of all threads may be dumped at any time in Chrome's trace-event format,
+ * for chrome://tracing or Perfetto; events recorded while dumping may come out torn,
+ * hence the dump is best taken in between frames.
+ *
+ * Scopes are only compiled in when OPENGLTEST_PROFILE is defined; otherwise they
+ * expand to nothing.
+ */
+class Profiler
+{
+public:
+
+#ifdef OPENGLTEST_PROFILE
+    static constexpr bool IsCompiledIn = true;
+#else
+    static constexpr bool IsCompiledIn = false;
+#endif
+
+    /*
+     * Nanoseconds since the profiler's epoch.
+     */
+    static int64_t Now();
+
+    static void RecordEvent(
+        char const * name,
+        int64_t startTime,
+        int64_t endTime);
+
+    /*
+     * Writes all the events recorded so far; throws GameException if the file
+     * cannot be written.
+     */
+    static void WriteChromeTrace(std::string const & filePath);
+
+    struct ScopeTime
+    {
+        char const * Name;
+        size_t Count;
+        int64_t TotalTime;
+    };
+
+    /*
+     * The number of events and their total time for each scope name, over the
+     * events started at or after the specified time that are still buffered;
+     * sorted by name.
+     */
+    static std::vector<ScopeTime> GetScopeTimes(int64_t sinceTime);
+};
+
+class ProfileScope
+{
+public:
+
+    explicit ProfileScope(char const * name)
+        : mName(name)
+        , mStartTime(Profiler::Now())
+    {}
+
+    ~ProfileScope()
+    {
+        Profiler::RecordEvent(mName, mStartTime, Profiler::Now());
+    }
+
+    ProfileScope(ProfileScope const & other) = delete;
+    ProfileScope & operator=(ProfileScope const & other) = delete;
+
+private:
+
+    char const * const mName;
+    int64_t const mStartTime;
+};
+
+#ifdef OPENGLTEST_PROFILE
+#define PROFILE_SCOPE_CONCAT_INNER(a, b) a##b
+#define PROFILE_SCOPE_CONCAT(a, b) PROFILE_SCOPE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_SCOPE_CONCAT(_profileScope, __LINE__)(name)
+#else
+#define PROFILE_SCOPE(name)
+#endif
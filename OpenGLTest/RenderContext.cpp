@@ -6,8 +6,13 @@
 #include "RenderContext.h"
 
 #include "GameException.h"
+#include "Profiler.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
 #include <cstring>
+#include <iterator>
 
 RenderContext::RenderContext()
     // Land
@@ -15,48 +20,126 @@ RenderContext::RenderContext()
     , mLandShaderLandColorParameter(0)
     , mLandShaderAmbientLightIntensityParameter(0)
     , mLandShaderOrthoMatrixParameter(0)
+    , mLandShaderParameterGenerations()
     , mLandBuffer()
     , mLandBufferSize(0u)
     , mLandBufferMaxSize(0u)
     , mLandVBO(0u)
+    , mLandVAO(0u)
+    , mLandVersion(0u)
     // Water
     , mWaterShaderProgram(0u)
     , mWaterShaderWaterColorParameter(0)
     , mWaterShaderAmbientLightIntensityParameter(0)
     , mWaterShaderOrthoMatrixParameter(0)
+    , mWaterShaderParameterGenerations()
     , mWaterBuffer()
     , mWaterBufferSize(0u)
     , mWaterBufferMaxSize(0u)
     , mWaterVBO(0u)
+    , mWaterVAO(0u)
+    // Water surface
+    , mWaterSurfaceShaderProgram(0u)
+    , mWaterSurfaceShaderWaterColorParameter(0)
+    , mWaterSurfaceShaderAmbientLightIntensityParameter(0)
+    , mWaterSurfaceShaderOrthoMatrixParameter(0)
+    , mWaterSurfaceShaderParameterGenerations()
+    , mWaterSurfaceShaderTimeParameter(0)
+    , mWaterSurfaceShaderWaveHeightParameter(0)
+    , mWaterSurfaceBuffer()
+    , mWaterSurfaceBufferSize(0u)
+    , mWaterSurfaceBufferMaxSize(0u)
+    , mWaterSurfaceVBO(0u)
+    , mWaterSurfaceVAO(0u)
+    , mWaterSurfaceVersion(0u)
     // Ship points
     , mShipPointShaderProgram(0u)
+    , mShipPointShaderAmbientLightIntensityParameter(0)
     , mShipPointShaderOrthoMatrixParameter(0)
-    , mShipPointBuffer()
-    , mShipPointBufferSize(0u)
-    , mShipPointBufferMaxSize(0u)   
-    , mShipPointVBO(0u)
+    , mShipPointShaderParameterGenerations()
+    , mShipPointPositionBuffer(nullptr)
+    , mShipPointPositionBufferSize(0u)
+    , mShipPointPositionBufferMaxSize(0u)
+    , mShipPointColourBuffer(nullptr)
+    , mShipPointWaterBuffer(nullptr)
+    , mShipPointLightBuffer(nullptr)
+    , mShipPointColourBufferSize(0u)
+    , mShipPointColourBufferMaxSize(0u)
+    , mShipPointPositionStream()
+    , mShipPointColourStream()
+    , mAreShipPointPositionsDirty(true)
+    , mAreShipPointColoursDirty(true)
+    , mShipPointPositionCount(0u)
+    , mShipPointColourCount(0u)
+    , mShipPointVAO()
     // Springs
     , mSpringShaderProgram(0u)
+    , mSpringShaderAmbientLightIntensityParameter(0)
     , mSpringShaderOrthoMatrixParameter(0)
+    , mSpringShaderParameterGenerations()
     , mSpringBuffer()
     , mSpringBufferSize(0u)
     , mSpringBufferMaxSize(0u)
     , mSpringVBO(0u)
+    , mSpringVAO()
     // Stressed springs
     , mStressedSpringShaderProgram(0u)
     , mStressedSpringShaderAmbientLightIntensityParameter(0)
     , mStressedSpringShaderOrthoMatrixParameter(0)
+    , mStressedSpringShaderParameterGenerations()
     , mStressedSpringBuffer()
     , mStressedSpringBufferSize(0u)
     , mStressedSpringBufferMaxSize(0u)
     , mStressedSpringVBO(0u)
+    , mStressedSpringVAO()
+    , mStressedSpringCount(0u)
+    , mStressedSpringVBOCapacity(0u)
+    , mStressedSpringsVersion(0u)
     // Ship triangles
     , mShipTriangleShaderProgram(0u)
+    , mShipTriangleShaderAmbientLightIntensityParameter(0)
     , mShipTriangleShaderOrthoMatrixParameter(0)
+    , mShipTriangleShaderParameterGenerations()
     , mShipTriangleBuffer()
     , mShipTriangleBufferSize(0u)
     , mShipTriangleBufferMaxSize(0u)
     , mShipTriangleVBO(0u)
+    , mShipTriangleVAO()
+    , mShipTopologyVersion(0u)
+    , mSpringIndexType(GL_UNSIGNED_INT)
+    , mSpringChunks()
+    , mShipTriangleIndexType(GL_UNSIGNED_INT)
+    , mShipTriangleChunks()
+    , mUseShipIndexChunks(false)
+    // Vertex array objects
+    , mUseVertexArrayObjects(0 != GLAD_GL_ARB_vertex_array_object)
+    , mAttributeSetupCallsSaved(0u)
+    // State
+    , mGLState()
+    // GPU timing
+    , mGpuPassTimer()
+    // CPU timing
+    , mCpuPassStartTime()
+    , mCurrentTimedPass(RenderPass::Land)
+    , mCpuPassTimes()
+    , mAverageCpuPassTimes()
+    , mLastRenderStartTime()
+    , mAverageFrameTime(0.0f)
+    // Frame counters
+    , mFrameCounters()
+    , mLastFrameCounters()
+    // Memory accounting
+    , mBufferMemory()
+    , mTotalBufferMemory()
+    // Performance overlay
+    , mShowPerformanceOverlay(false)
+    , mPerformanceOverlay()
+    , mOverlayShaderProgram(0u)
+    , mOverlayShaderCanvasSizeParameter(0)
+    , mOverlayShaderParameterGenerations()
+    , mOverlayVBO(0u)
+    , mOverlayVAO(0u)
+    , mOverlayFontTexture(0u)
     // Render parameters
     , mZoom(1.0f)
     , mCamX(0.0f)
@@ -64,8 +147,13 @@ RenderContext::RenderContext()
     , mCanvasWidth(100)
     , mCanvasHeight(100)
     , mAmbientLightIntensity(1.0f)
+    , mOrthoMatrixGeneration(1u)
+    , mAmbientLightIntensityGeneration(1u)
 {
+    PROFILE_SCOPE("RenderContext::RenderContext");
+
     GLuint tmpVBO;
+    GLuint tmpVAO;
 
     //
     // Check OpenGL version
@@ -129,6 +217,20 @@ RenderContext::RenderContext()
     // Create VBO    
     glGenBuffers(1, &tmpVBO);
     mLandVBO = tmpVBO;
+
+    if (mUseVertexArrayObjects)
+    {
+        // Create VAO
+        glGenVertexArrays(1, &tmpVAO);
+        mLandVAO = tmpVAO;
+
+        // Describe InputPos
+        glBindVertexArray(*mLandVAO);
+        glBindBuffer(GL_ARRAY_BUFFER, *mLandVBO);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(0);
+        glBindVertexArray(0);
+    }
     
     // Set hardcoded parameters
     glUseProgram(*mLandShaderProgram);
@@ -179,18 +281,113 @@ RenderContext::RenderContext()
     glGenBuffers(1, &tmpVBO);    
     mWaterVBO = tmpVBO;
 
+    if (mUseVertexArrayObjects)
+    {
+        // Create VAO
+        glGenVertexArrays(1, &tmpVAO);
+        mWaterVAO = tmpVAO;
+
+        // Describe InputPos
+        glBindVertexArray(*mWaterVAO);
+        glBindBuffer(GL_ARRAY_BUFFER, *mWaterVBO);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(0);
+        glBindVertexArray(0);
+    }
+
     // Set hardcoded parameters
     glUseProgram(*mWaterShaderProgram);
     glUniform4f(mWaterShaderWaterColorParameter, 0.0f, 0.25f, 1.0f, 0.5f);
     glUseProgram(0);
 
 
+    //
+    // Create water surface program
+    //
+
+    mWaterSurfaceShaderProgram = glCreateProgram();
+
+    char const * waterSurfaceVertexShaderSource = R"(
+        attribute vec3 inputPos; // x, y, displacement weight
+        uniform mat4 paramOrthoMatrix;
+        uniform float paramTime;
+        uniform float paramWaveHeight;
+        void main()
+        {
+            float c1 = sin(inputPos.x * 0.1 + paramTime) * 0.5;
+            float c2 = sin(inputPos.x * 0.3 - paramTime * 1.1) * 0.3;
+            float y = inputPos.y + inputPos.z * (c1 + c2) * paramWaveHeight;
+            gl_Position = paramOrthoMatrix * vec4(inputPos.x, y, -1.0, 1.0);
+        }
+    )";
+
+    CompileShader(waterSurfaceVertexShaderSource, GL_VERTEX_SHADER, mWaterSurfaceShaderProgram);
+
+    CompileShader(waterFragmentShaderSource, GL_FRAGMENT_SHADER, mWaterSurfaceShaderProgram);
+
+    // Bind attribute locations
+    glBindAttribLocation(*mWaterSurfaceShaderProgram, 0, "inputPos");
+
+    // Link
+    LinkProgram(mWaterSurfaceShaderProgram, "Water Surface");
+
+    // Get uniform locations    
+    mWaterSurfaceShaderWaterColorParameter = GetParameterLocation(mWaterSurfaceShaderProgram, "paramWaterColor");
+    mWaterSurfaceShaderAmbientLightIntensityParameter = GetParameterLocation(mWaterSurfaceShaderProgram, "paramAmbientLightIntensity");
+    mWaterSurfaceShaderOrthoMatrixParameter = GetParameterLocation(mWaterSurfaceShaderProgram, "paramOrthoMatrix");
+    mWaterSurfaceShaderTimeParameter = GetParameterLocation(mWaterSurfaceShaderProgram, "paramTime");
+    mWaterSurfaceShaderWaveHeightParameter = GetParameterLocation(mWaterSurfaceShaderProgram, "paramWaveHeight");
+
+    // Create VBO
+    glGenBuffers(1, &tmpVBO);    
+    mWaterSurfaceVBO = tmpVBO;
+
+    if (mUseVertexArrayObjects)
+    {
+        // Create VAO
+        glGenVertexArrays(1, &tmpVAO);
+        mWaterSurfaceVAO = tmpVAO;
+
+        // Describe InputPos
+        glBindVertexArray(*mWaterSurfaceVAO);
+        glBindBuffer(GL_ARRAY_BUFFER, *mWaterSurfaceVBO);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(0);
+        glBindVertexArray(0);
+    }
+
+    // Set hardcoded parameters
+    glUseProgram(*mWaterSurfaceShaderProgram);
+    glUniform4f(mWaterSurfaceShaderWaterColorParameter, 0.0f, 0.25f, 1.0f, 0.5f);
+    glUseProgram(0);
+
+
     //
     // Ship points
     //
 
-    glGenBuffers(1, &tmpVBO);
-    mShipPointVBO = tmpVBO;
+    // Only re-written when invalidated, as the points are shaded in the shaders
+    mShipPointPositionStream = std::make_unique<StreamingBuffer>(1u);
+    mShipPointColourStream = std::make_unique<StreamingBuffer>(1u);
+
+    // Shading of ship points, shared by all the ship shaders; mirrors what used
+    // to be done on the CPU, but with the ambient light intensity as a parameter
+    std::string const shipPointColourShaderSource = R"(
+
+        vec3 CalculateShipPointColour(vec3 colour, float water, float light, float ambientLightIntensity)
+        {
+            const vec3 LightPointColour = vec3(1.0, 1.0, 0.25);
+            const vec3 WetPointColour = vec3(0.0, 0.0, 0.8);
+
+            float colorWetness = min(water, 1.0) * 0.7;
+
+            vec3 colour1 = colour * (1.0 - colorWetness) + WetPointColour * colorWetness;
+
+            colour1 *= ambientLightIntensity;
+
+            return colour1 * (1.0 - light) + LightPointColour * light;
+        }
+    )";
 
 
     //
@@ -199,27 +396,30 @@ RenderContext::RenderContext()
 
     mShipPointShaderProgram = glCreateProgram();
 
-    char const * shipPointShaderSource = R"(
+    std::string const shipPointShaderSource = shipPointColourShaderSource + R"(
 
         // Inputs
         attribute vec2 inputPos;
         attribute vec3 inputCol;
+        attribute float inputWater;
+        attribute float inputLight;
 
         // Outputs
         varying vec3 vertexCol;
 
         // Params
         uniform mat4 paramOrthoMatrix;
+        uniform float paramAmbientLightIntensity;
 
         void main()
         {
-            vertexCol = inputCol;
+            vertexCol = CalculateShipPointColour(inputCol, inputWater, inputLight, paramAmbientLightIntensity);
 
             gl_Position = paramOrthoMatrix * vec4(inputPos.xy, -1.0, 1.0);
         }
     )";
 
-    CompileShader(shipPointShaderSource, GL_VERTEX_SHADER, mShipPointShaderProgram);
+    CompileShader(shipPointShaderSource.c_str(), GL_VERTEX_SHADER, mShipPointShaderProgram);
 
     char const * shipPointFragmentShaderSource = R"(
 
@@ -237,13 +437,19 @@ RenderContext::RenderContext()
     // Bind attribute locations
     glBindAttribLocation(*mShipPointShaderProgram, 0, "inputPos");
     glBindAttribLocation(*mShipPointShaderProgram, 1, "inputCol");
+    glBindAttribLocation(*mShipPointShaderProgram, 2, "inputWater");
+    glBindAttribLocation(*mShipPointShaderProgram, 3, "inputLight");
 
     // Link
     LinkProgram(mShipPointShaderProgram, "Ship Point");
 
     // Get uniform locations
+    mShipPointShaderAmbientLightIntensityParameter = GetParameterLocation(mShipPointShaderProgram, "paramAmbientLightIntensity");
     mShipPointShaderOrthoMatrixParameter = GetParameterLocation(mShipPointShaderProgram, "paramOrthoMatrix");
 
+    // Create VAO
+    CreateShipPointsVAO(mShipPointVAO, 0u);
+
     // Set hardcoded parameters    
     glUseProgram(*mShipPointShaderProgram);
     glUseProgram(0);
@@ -255,27 +461,30 @@ RenderContext::RenderContext()
 
     mSpringShaderProgram = glCreateProgram();
 
-    char const * springShaderSource = R"(
+    std::string const springShaderSource = shipPointColourShaderSource + R"(
 
         // Inputs
         attribute vec2 inputPos;
         attribute vec3 inputCol;
+        attribute float inputWater;
+        attribute float inputLight;
 
         // Outputs
         varying vec3 vertexCol;
 
         // Params
         uniform mat4 paramOrthoMatrix;
+        uniform float paramAmbientLightIntensity;
 
         void main()
         {
-            vertexCol = inputCol;
+            vertexCol = CalculateShipPointColour(inputCol, inputWater, inputLight, paramAmbientLightIntensity);
 
             gl_Position = paramOrthoMatrix * vec4(inputPos.xy, -1.0, 1.0);
         }
     )";
 
-    CompileShader(springShaderSource, GL_VERTEX_SHADER, mSpringShaderProgram);
+    CompileShader(springShaderSource.c_str(), GL_VERTEX_SHADER, mSpringShaderProgram);
 
     char const * springFragmentShaderSource = R"(
 
@@ -293,17 +502,23 @@ RenderContext::RenderContext()
     // Bind attribute locations
     glBindAttribLocation(*mSpringShaderProgram, 0, "inputPos");
     glBindAttribLocation(*mSpringShaderProgram, 1, "inputCol");
+    glBindAttribLocation(*mSpringShaderProgram, 2, "inputWater");
+    glBindAttribLocation(*mSpringShaderProgram, 3, "inputLight");
 
     // Link
     LinkProgram(mSpringShaderProgram, "Spring");
 
     // Get uniform locations
+    mSpringShaderAmbientLightIntensityParameter = GetParameterLocation(mSpringShaderProgram, "paramAmbientLightIntensity");
     mSpringShaderOrthoMatrixParameter = GetParameterLocation(mSpringShaderProgram, "paramOrthoMatrix");
 
     // Create VBOs
     glGenBuffers(1, &tmpVBO);
     mSpringVBO = tmpVBO;
 
+    // Create VAO
+    CreateShipPointsVAO(mSpringVAO, *mSpringVBO);
+
     // Set hardcoded parameters    
     glUseProgram(*mSpringShaderProgram);
     glUseProgram(0);
@@ -358,6 +573,9 @@ RenderContext::RenderContext()
     glGenBuffers(1, &tmpVBO);
     mStressedSpringVBO = tmpVBO;
 
+    // Create VAO
+    CreateShipPointsVAO(mStressedSpringVAO, *mStressedSpringVBO);
+
     // Set hardcoded parameters    
     glUseProgram(*mStressedSpringShaderProgram);
     glUseProgram(0);
@@ -369,27 +587,30 @@ RenderContext::RenderContext()
 
     mShipTriangleShaderProgram = glCreateProgram();
 
-    char const * shipTriangleShaderSource = R"(
+    std::string const shipTriangleShaderSource = shipPointColourShaderSource + R"(
 
         // Inputs
         attribute vec2 inputPos;
         attribute vec3 inputCol;
+        attribute float inputWater;
+        attribute float inputLight;
 
         // Outputs
         varying vec3 vertexCol;
 
         // Params
         uniform mat4 paramOrthoMatrix;
+        uniform float paramAmbientLightIntensity;
 
         void main()
         {
-            vertexCol = inputCol;
+            vertexCol = CalculateShipPointColour(inputCol, inputWater, inputLight, paramAmbientLightIntensity);
 
             gl_Position = paramOrthoMatrix * vec4(inputPos.xy, -1.0, 1.0);
         }
     )";
 
-    CompileShader(shipTriangleShaderSource, GL_VERTEX_SHADER, mShipTriangleShaderProgram);
+    CompileShader(shipTriangleShaderSource.c_str(), GL_VERTEX_SHADER, mShipTriangleShaderProgram);
 
     char const * shipTriangleFragmentShaderSource = R"(
 
@@ -407,23 +628,147 @@ RenderContext::RenderContext()
     // Bind attribute locations
     glBindAttribLocation(*mShipTriangleShaderProgram, 0, "inputPos");
     glBindAttribLocation(*mShipTriangleShaderProgram, 1, "inputCol");
+    glBindAttribLocation(*mShipTriangleShaderProgram, 2, "inputWater");
+    glBindAttribLocation(*mShipTriangleShaderProgram, 3, "inputLight");
 
     // Link
     LinkProgram(mShipTriangleShaderProgram, "ShipTriangle");
 
     // Get uniform locations
+    mShipTriangleShaderAmbientLightIntensityParameter = GetParameterLocation(mShipTriangleShaderProgram, "paramAmbientLightIntensity");
     mShipTriangleShaderOrthoMatrixParameter = GetParameterLocation(mShipTriangleShaderProgram, "paramOrthoMatrix");
 
     // Create VBO
     glGenBuffers(1, &tmpVBO);
     mShipTriangleVBO = tmpVBO;
 
+    // Create VAO
+    CreateShipPointsVAO(mShipTriangleVAO, *mShipTriangleVBO);
+
     glUseProgram(*mShipTriangleShaderProgram);
 
     // Set hardcoded parameters    
         
     glUseProgram(0);
 
+    //
+    // Set anti-aliasing for lines
+    //
+
+    glHint(GL_LINE_SMOOTH_HINT, GL_NICEST);
+
+    //
+    // Create GPU timer
+    //
+
+    mGpuPassTimer = std::make_unique<GpuPassTimer>(static_cast<size_t>(RenderPass::_Count));
+
+    //
+    // Create performance overlay program
+    //
+
+    mOverlayShaderProgram = glCreateProgram();
+
+    char const * overlayVertexShaderSource = R"(
+
+        // Inputs
+        attribute vec2 inputPos; // Pixels from the top-left corner
+        attribute vec2 inputTexturePos;
+        attribute vec4 inputCol;
+
+        // Outputs
+        varying vec2 vertexTexturePos;
+        varying vec4 vertexCol;
+
+        // Params
+        uniform vec2 paramCanvasSize;
+
+        void main()
+        {
+            vertexTexturePos = inputTexturePos;
+            vertexCol = inputCol;
+
+            gl_Position = vec4(
+                inputPos.x / paramCanvasSize.x * 2.0 - 1.0,
+                1.0 - inputPos.y / paramCanvasSize.y * 2.0,
+                -1.0,
+                1.0);
+        }
+    )";
+
+    CompileShader(overlayVertexShaderSource, GL_VERTEX_SHADER, mOverlayShaderProgram);
+
+    char const * overlayFragmentShaderSource = R"(
+
+        // Inputs from previous shader
+        varying vec2 vertexTexturePos;
+        varying vec4 vertexCol;
+
+        // The font, whose solid area serves the untextured quads
+        uniform sampler2D paramFontTexture;
+
+        void main()
+        {
+            gl_FragColor = vec4(vertexCol.rgb, vertexCol.a * texture2D(paramFontTexture, vertexTexturePos).a);
+        } 
+    )";
+
+    CompileShader(overlayFragmentShaderSource, GL_FRAGMENT_SHADER, mOverlayShaderProgram);
+
+    // Bind attribute locations
+    glBindAttribLocation(*mOverlayShaderProgram, 0, "inputPos");
+    glBindAttribLocation(*mOverlayShaderProgram, 1, "inputTexturePos");
+    glBindAttribLocation(*mOverlayShaderProgram, 2, "inputCol");
+
+    // Link
+    LinkProgram(mOverlayShaderProgram, "Overlay");
+
+    // Get uniform locations
+    mOverlayShaderCanvasSizeParameter = GetParameterLocation(mOverlayShaderProgram, "paramCanvasSize");
+    GLint const overlayShaderFontTextureParameter = GetParameterLocation(mOverlayShaderProgram, "paramFontTexture");
+
+    // Create VBO
+    glGenBuffers(1, &tmpVBO);
+    mOverlayVBO = tmpVBO;
+
+    if (mUseVertexArrayObjects)
+    {
+        // Create VAO
+        glGenVertexArrays(1, &tmpVAO);
+        mOverlayVAO = tmpVAO;
+
+        glBindVertexArray(*mOverlayVAO);
+        glBindBuffer(GL_ARRAY_BUFFER, *mOverlayVBO);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(PerformanceOverlay::Vertex), (void*)offsetof(PerformanceOverlay::Vertex, x));
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(PerformanceOverlay::Vertex), (void*)offsetof(PerformanceOverlay::Vertex, u));
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(PerformanceOverlay::Vertex), (void*)offsetof(PerformanceOverlay::Vertex, r));
+        glEnableVertexAttribArray(2);
+        glBindVertexArray(0);
+    }
+
+    // Create font texture
+    GLuint tmpTexture;
+    glGenTextures(1, &tmpTexture);
+    mOverlayFontTexture = tmpTexture;
+
+    std::vector<uint8_t> const fontTexels = PerformanceOverlay::MakeFontTexture();
+
+    glBindTexture(GL_TEXTURE_2D, *mOverlayFontTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, PerformanceOverlay::FontTextureWidth, PerformanceOverlay::FontTextureHeight, 0, GL_ALPHA, GL_UNSIGNED_BYTE, fontTexels.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    // Set hardcoded parameters
+    glUseProgram(*mOverlayShaderProgram);
+    glUniform1i(overlayShaderFontTextureParameter, 0);
+    glUseProgram(0);
+
     //
     // Initialize ortho matrix
     //
@@ -442,6 +787,58 @@ RenderContext::~RenderContext()
     glUseProgram(0u);
 }
 
+char const * RenderContext::GetBufferTypeName(BufferType bufferType)
+{
+    switch (bufferType)
+    {
+        case BufferType::Land:
+            return "Land";
+        case BufferType::Water:
+            return "Water";
+        case BufferType::WaterSurface:
+            return "Water Surface";
+        case BufferType::ShipPointPositions:
+            return "Point Positions";
+        case BufferType::ShipPointColours:
+            return "Point Colours";
+        case BufferType::Springs:
+            return "Springs";
+        case BufferType::ShipTriangles:
+            return "Triangles";
+        case BufferType::StressedSprings:
+            return "Stressed Springs";
+        case BufferType::_Count:
+            break;
+    }
+
+    assert(false);
+    return "";
+}
+
+char const * RenderContext::GetRenderPassName(RenderPass pass)
+{
+    switch (pass)
+    {
+        case RenderPass::Land:
+            return "Land";
+        case RenderPass::Water:
+            return "Water";
+        case RenderPass::ShipPoints:
+            return "Points";
+        case RenderPass::Springs:
+            return "Springs";
+        case RenderPass::StressedSprings:
+            return "Stressed Springs";
+        case RenderPass::ShipTriangles:
+            return "Triangles";
+        case RenderPass::_Count:
+            break;
+    }
+
+    assert(false);
+    return "";
+}
+
 //////////////////////////////////////////////////////////////////////////////////
 
 void RenderContext::RenderStart()
@@ -455,48 +852,96 @@ void RenderContext::RenderStart()
     glClearColor(clearColor.x, clearColor.y, clearColor.z, 1.0f); 
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-    // Set anti-aliasing for lines
-    glEnable(GL_LINE_SMOOTH);
-    glHint(GL_LINE_SMOOTH, GL_NICEST);
-}
+    mAttributeSetupCallsSaved = 0u;
+    mGLState.ResetStatistics();
+    mFrameCounters = FrameCounters();
 
-void RenderContext::RenderLandStart(size_t slices)
-{
-    if (slices + 1 != mLandBufferMaxSize)
+    mGpuPassTimer->BeginFrame();
+
+    auto const now = std::chrono::steady_clock::now();
+
+    if (mLastRenderStartTime != std::chrono::steady_clock::time_point())
     {
-        // Realloc
-        mLandBuffer.reset();
-        mLandBuffer.reset(new LandElement[slices + 1]);
-        mLandBufferMaxSize = slices + 1;
+        float const frameTime = std::chrono::duration<float, std::milli>(now - mLastRenderStartTime).count();
+        mAverageFrameTime += (frameTime - mAverageFrameTime) / 32.0f;
+        mPerformanceOverlay.AddFrameTime(frameTime);
     }
 
+    mLastRenderStartTime = now;
+
+    std::fill(std::begin(mCpuPassTimes), std::end(mCpuPassTimes), 0.0f);
+    mCpuPassStartTime = now;
+}
+
+void RenderContext::UploadLandStart(
+    uint64_t version,
+    size_t slices)
+{
+    mLandVersion = version;
+
+    mLandBuffer.reset(new LandElement[slices + 1]);
+    mLandBufferMaxSize = slices + 1;
+    TrackStagingAllocation(BufferType::Land, mLandBufferMaxSize * sizeof(LandElement));
+
     mLandBufferSize = 0u;    
 }
 
-void RenderContext::RenderLandEnd()
+void RenderContext::UploadLandEnd()
 {
     assert(mLandBufferSize == mLandBufferMaxSize);
 
+    // Upload land buffer 
+    mGLState.BindArrayBuffer(*mLandVBO);
+    glBufferData(GL_ARRAY_BUFFER, mLandBufferSize * sizeof(LandElement), mLandBuffer.get(), GL_STATIC_DRAW);
+    CountUpload(BufferType::Land, mLandBufferSize * sizeof(LandElement));
+    TrackGpuAllocation(BufferType::Land, mLandBufferSize * sizeof(LandElement));
+
+    // The GPU has its own copy now; we only need to remember the count
+    mLandBuffer.reset();
+    TrackStagingRelease(BufferType::Land);
+}
+
+void RenderContext::RenderLand()
+{
+    assert(0u != mLandVersion);
+
     // Use program
-    glUseProgram(*mLandShaderProgram);
+    mGLState.UseProgram(*mLandShaderProgram);
 
     // Set parameters
-    glUniform1f(mLandShaderAmbientLightIntensityParameter, mAmbientLightIntensity);
-    glUniformMatrix4fv(mLandShaderOrthoMatrixParameter, 1, GL_FALSE, &(mOrthoMatrix[0][0]));
+    SetCommonParameters(
+        mLandShaderParameterGenerations,
+        mLandShaderAmbientLightIntensityParameter,
+        mLandShaderOrthoMatrixParameter);
 
-    // Upload land buffer 
-    glBindBuffer(GL_ARRAY_BUFFER, *mLandVBO);
-    glBufferData(GL_ARRAY_BUFFER, mLandBufferSize * sizeof(LandElement), mLandBuffer.get(), GL_DYNAMIC_DRAW);
+    if (mUseVertexArrayObjects)
+    {
+        mGLState.BindVertexArray(*mLandVAO);
 
-    // Describe InputPos
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
+        mAttributeSetupCallsSaved += 2;
+    }
+    else
+    {
+        // Bind land buffer 
+        mGLState.BindArrayBuffer(*mLandVBO);
+
+        // Describe InputPos
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(0);
+
+        mFrameCounters.AttributeSetups += 2;
+    }
+
+    // Land is opaque
+    mGLState.SetCapability(GL_BLEND, false);
+
+    BeginTimedPass(RenderPass::Land);
 
     // Draw
     glDrawArrays(GL_TRIANGLE_STRIP, 0, static_cast<GLsizei>(2 * mLandBufferSize));
+    ++mFrameCounters.DrawCalls;
 
-    // Stop using program
-    glUseProgram(0);
+    EndTimedPass();
 }
 
 void RenderContext::RenderWaterStart(size_t slices)
@@ -507,6 +952,7 @@ void RenderContext::RenderWaterStart(size_t slices)
         mWaterBuffer.reset();
         mWaterBuffer.reset(new WaterElement[slices + 1]);
         mWaterBufferMaxSize = slices + 1;
+        TrackStagingAllocation(BufferType::Water, mWaterBufferMaxSize * sizeof(WaterElement));
     }
 
     mWaterBufferSize = 0u;
@@ -517,116 +963,326 @@ void RenderContext::RenderWaterEnd()
     assert(mWaterBufferSize == mWaterBufferMaxSize);
 
     // Use program
-    glUseProgram(*mWaterShaderProgram);
+    mGLState.UseProgram(*mWaterShaderProgram);
 
     // Set parameters
-    glUniform1f(mWaterShaderAmbientLightIntensityParameter, mAmbientLightIntensity);
-    glUniformMatrix4fv(mWaterShaderOrthoMatrixParameter, 1, GL_FALSE, &(mOrthoMatrix[0][0]));
+    SetCommonParameters(
+        mWaterShaderParameterGenerations,
+        mWaterShaderAmbientLightIntensityParameter,
+        mWaterShaderOrthoMatrixParameter);
 
     // Upload water buffer 
-    glBindBuffer(GL_ARRAY_BUFFER, *mWaterVBO);
+    mGLState.BindArrayBuffer(*mWaterVBO);
     glBufferData(GL_ARRAY_BUFFER, mWaterBufferSize * sizeof(WaterElement), mWaterBuffer.get(), GL_DYNAMIC_DRAW);
+    CountUpload(BufferType::Water, mWaterBufferSize * sizeof(WaterElement));
+    TrackGpuAllocation(BufferType::Water, mWaterBufferSize * sizeof(WaterElement));
 
-    // Describe InputPos
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
+    if (mUseVertexArrayObjects)
+    {
+        mGLState.BindVertexArray(*mWaterVAO);
+
+        mAttributeSetupCallsSaved += 2;
+    }
+    else
+    {
+        // Describe InputPos
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(0);
+
+        mFrameCounters.AttributeSetups += 2;
+    }
 
     // Enable blend (to make water half-transparent, half-opaque)
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    mGLState.SetCapability(GL_BLEND, true);
+    mGLState.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    BeginTimedPass(RenderPass::Water);
 
     // Draw
     glDrawArrays(GL_TRIANGLE_STRIP, 0, static_cast<GLsizei>(2 * mWaterBufferSize));
+    ++mFrameCounters.DrawCalls;
 
-    // Stop using program
-    glUseProgram(0);
+    EndTimedPass();
 }
 
-void RenderContext::UploadShipPointStart(size_t points)
+void RenderContext::UploadWaterSurfaceStart(
+    uint64_t version,
+    size_t slices)
 {
-    if (points != mShipPointBufferMaxSize)
+    mWaterSurfaceVersion = version;
+
+    mWaterSurfaceBuffer.reset(new WaterSurfaceElement[slices + 1]);
+    mWaterSurfaceBufferMaxSize = slices + 1;
+    TrackStagingAllocation(BufferType::WaterSurface, mWaterSurfaceBufferMaxSize * sizeof(WaterSurfaceElement));
+
+    mWaterSurfaceBufferSize = 0u;
+}
+
+void RenderContext::UploadWaterSurfaceEnd()
+{
+    assert(mWaterSurfaceBufferSize == mWaterSurfaceBufferMaxSize);
+
+    // Upload water surface buffer 
+    mGLState.BindArrayBuffer(*mWaterSurfaceVBO);
+    glBufferData(GL_ARRAY_BUFFER, mWaterSurfaceBufferSize * sizeof(WaterSurfaceElement), mWaterSurfaceBuffer.get(), GL_STATIC_DRAW);
+    CountUpload(BufferType::WaterSurface, mWaterSurfaceBufferSize * sizeof(WaterSurfaceElement));
+    TrackGpuAllocation(BufferType::WaterSurface, mWaterSurfaceBufferSize * sizeof(WaterSurfaceElement));
+
+    // The GPU has its own copy now; we only need to remember the count
+    mWaterSurfaceBuffer.reset();
+    TrackStagingRelease(BufferType::WaterSurface);
+}
+
+void RenderContext::RenderWaterSurface(
+    float time,
+    float waveHeight)
+{
+    assert(0u != mWaterSurfaceVersion);
+
+    // Use program
+    mGLState.UseProgram(*mWaterSurfaceShaderProgram);
+
+    // Set parameters
+    SetCommonParameters(
+        mWaterSurfaceShaderParameterGenerations,
+        mWaterSurfaceShaderAmbientLightIntensityParameter,
+        mWaterSurfaceShaderOrthoMatrixParameter);
+    glUniform1f(mWaterSurfaceShaderTimeParameter, time);
+    glUniform1f(mWaterSurfaceShaderWaveHeightParameter, waveHeight);
+    mFrameCounters.UniformUploads += 2;
+
+    if (mUseVertexArrayObjects)
     {
-        // Realloc
-        mShipPointBuffer.reset();
-        mShipPointBuffer.reset(new ShipPointElement[points]);
-        mShipPointBufferMaxSize = points;
+        mGLState.BindVertexArray(*mWaterSurfaceVAO);
+
+        mAttributeSetupCallsSaved += 2;
+    }
+    else
+    {
+        // Bind water surface buffer 
+        mGLState.BindArrayBuffer(*mWaterSurfaceVBO);
+
+        // Describe InputPos
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(0);
+
+        mFrameCounters.AttributeSetups += 2;
     }
 
-    mShipPointBufferSize = 0u;
+    // Enable blend (to make water half-transparent, half-opaque)
+    mGLState.SetCapability(GL_BLEND, true);
+    mGLState.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    BeginTimedPass(RenderPass::Water);
+
+    // Draw
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, static_cast<GLsizei>(2 * mWaterSurfaceBufferSize));
+    ++mFrameCounters.DrawCalls;
+
+    EndTimedPass();
+}
+
+void RenderContext::UploadShipPointPositionsStart(size_t points)
+{
+    // Positions get written directly into the next stream segment
+    mShipPointPositionBuffer = static_cast<ShipPointPositionElement *>(mShipPointPositionStream->MapSegment(points * sizeof(ShipPointPositionElement)));
+    mGLState.InvalidateArrayBuffer();
+    mShipPointPositionBufferMaxSize = points;
+
+    mShipPointPositionBufferSize = 0u;
 }
 
-void RenderContext::UploadShipPointEnd()
+void RenderContext::UploadShipPointPositionsEnd()
 {
-    assert(mShipPointBufferSize == mShipPointBufferMaxSize);
+    assert(mShipPointPositionBufferSize == mShipPointPositionBufferMaxSize);
 
-    // Upload point buffer 
-    glBindBuffer(GL_ARRAY_BUFFER, *mShipPointVBO);
-    glBufferData(GL_ARRAY_BUFFER, mShipPointBufferSize * sizeof(ShipPointElement), mShipPointBuffer.get(), GL_DYNAMIC_DRAW);
+    // Hand the positions over to the GPU
+    mShipPointPositionStream->UnmapSegment();
+    mShipPointPositionBuffer = nullptr;
+
+    CommitShipPointPositions(mShipPointPositionBufferSize);
+}
+
+void RenderContext::UploadShipPointPositions(
+    vec2f const * positions,
+    size_t points)
+{
+    static_assert(sizeof(vec2f) == sizeof(ShipPointPositionElement), "vec2f must be laid out as a position element");
+
+    mShipPointPositionStream->UploadSegment({
+        { positions, points * sizeof(ShipPointPositionElement) } });
+
+    CommitShipPointPositions(points);
+}
+
+void RenderContext::UploadShipPointColoursStart(size_t points)
+{
+    // Colours get written directly into the next stream segment, each plane after the previous one
+    uint8_t * segmentPtr = static_cast<uint8_t *>(mShipPointColourStream->MapSegment(points * ShipPointColourBytes));
+    mShipPointColourBuffer = reinterpret_cast<ShipPointColourElement *>(segmentPtr);
+    mShipPointWaterBuffer = reinterpret_cast<float *>(segmentPtr + points * sizeof(ShipPointColourElement));
+    mShipPointLightBuffer = mShipPointWaterBuffer + points;
+    mGLState.InvalidateArrayBuffer();
+    mShipPointColourBufferMaxSize = points;
+
+    mShipPointColourBufferSize = 0u;
+}
+
+void RenderContext::UploadShipPointColoursEnd()
+{
+    assert(mShipPointColourBufferSize == mShipPointColourBufferMaxSize);
+
+    // Hand the colours over to the GPU
+    mShipPointColourStream->UnmapSegment();
+    mShipPointColourBuffer = nullptr;
+    mShipPointWaterBuffer = nullptr;
+    mShipPointLightBuffer = nullptr;
+
+    CommitShipPointColours(mShipPointColourBufferSize);
+}
+
+void RenderContext::UploadShipPointColours(
+    vec3f const * colours,
+    float const * waters,
+    float const * lights,
+    size_t points)
+{
+    static_assert(sizeof(vec3f) == sizeof(ShipPointColourElement), "vec3f must be laid out as a colour element");
+
+    mShipPointColourStream->UploadSegment({
+        { colours, points * sizeof(ShipPointColourElement) },
+        { waters, points * sizeof(float) },
+        { lights, points * sizeof(float) } });
+
+    CommitShipPointColours(points);
 }
 
 void RenderContext::RenderShipPoints()
 {
-    assert(mShipPointBufferSize == mShipPointBufferMaxSize);
+    assert(!mAreShipPointPositionsDirty && !mAreShipPointColoursDirty);
 
     // Use program
-    glUseProgram(*mShipPointShaderProgram);
+    mGLState.UseProgram(*mShipPointShaderProgram);
 
     // Set parameters
-    glUniformMatrix4fv(mShipPointShaderOrthoMatrixParameter, 1, GL_FALSE, &(mOrthoMatrix[0][0]));
+    SetCommonParameters(
+        mShipPointShaderParameterGenerations,
+        mShipPointShaderAmbientLightIntensityParameter,
+        mShipPointShaderOrthoMatrixParameter);
 
     // Bind ship points
-    glBindBuffer(GL_ARRAY_BUFFER, *mShipPointVBO);
-    DescribeShipPointsVBO();
+    BindShipPointsVAO(mShipPointVAO, 0u);
+
+    // Points are opaque
+    mGLState.SetCapability(GL_BLEND, false);
 
     // Set point size
-    glPointSize(0.15f * 2.0f * mCanvasHeight / mWorldHeight);
+    mGLState.SetPointSize(0.15f * 2.0f * mCanvasHeight / mWorldHeight);
+
+    BeginTimedPass(RenderPass::ShipPoints);
 
     // Draw
-    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(mShipPointBufferSize));
+    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(mShipPointPositionCount));
+    ++mFrameCounters.DrawCalls;
 
-    // Stop using program
-    glUseProgram(0);
+    EndTimedPass();
 }
 
-void RenderContext::RenderSpringsStart(size_t springs)
+void RenderContext::UploadShipTopologyStart(
+    uint64_t version,
+    size_t points,
+    size_t springs,
+    size_t triangles)
 {
-    if (springs != mSpringBufferMaxSize)
-    {
-        // Realloc
-        mSpringBuffer.reset();
-        mSpringBuffer.reset(new SpringElement[springs]);
-        mSpringBufferMaxSize = springs;
-    }
+    BeginShipTopology(version, points);
 
+    mSpringBuffer.reset(new SpringElement[springs]);
+    mSpringBufferMaxSize = springs;
     mSpringBufferSize = 0u;
+    TrackStagingAllocation(BufferType::Springs, mSpringBufferMaxSize * sizeof(SpringElement));
+
+    mShipTriangleBuffer.reset(new ShipTriangleElement[triangles]);
+    mShipTriangleBufferMaxSize = triangles;
+    mShipTriangleBufferSize = 0u;
+    TrackStagingAllocation(BufferType::ShipTriangles, mShipTriangleBufferMaxSize * sizeof(ShipTriangleElement));
 }
 
-void RenderContext::RenderSpringsEnd()
+void RenderContext::UploadShipTopologyEnd()
 {
     assert(mSpringBufferSize == mSpringBufferMaxSize);
+    assert(mShipTriangleBufferSize == mShipTriangleBufferMaxSize);
+
+    UploadShipTopologyIndices(
+        reinterpret_cast<int const *>(mSpringBuffer.get()),
+        mSpringBufferSize,
+        reinterpret_cast<int const *>(mShipTriangleBuffer.get()),
+        mShipTriangleBufferSize);
+
+    // The GPU has its own copy now; we only need to remember the counts
+    mSpringBuffer.reset();
+    TrackStagingRelease(BufferType::Springs);
+    mShipTriangleBuffer.reset();
+    TrackStagingRelease(BufferType::ShipTriangles);
+}
+
+void RenderContext::UploadShipTopology(
+    uint64_t version,
+    size_t points,
+    int const * springIndices,
+    size_t springs,
+    int const * triangleIndices,
+    size_t triangles)
+{
+    BeginShipTopology(version, points);
+
+    UploadShipTopologyIndices(
+        springIndices,
+        springs,
+        triangleIndices,
+        triangles);
+}
+
+void RenderContext::RenderSprings()
+{
+    assert(0u != mShipTopologyVersion);
 
     // Use program
-    glUseProgram(*mSpringShaderProgram);
+    mGLState.UseProgram(*mSpringShaderProgram);
 
     // Set parameters
-    glUniformMatrix4fv(mSpringShaderOrthoMatrixParameter, 1, GL_FALSE, &(mOrthoMatrix[0][0]));
-
-    // Bind ship points
-    glBindBuffer(GL_ARRAY_BUFFER, *mShipPointVBO);
-    DescribeShipPointsVBO();
+    SetCommonParameters(
+        mSpringShaderParameterGenerations,
+        mSpringShaderAmbientLightIntensityParameter,
+        mSpringShaderOrthoMatrixParameter);
 
-    // Upload springs buffer 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *mSpringVBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, mSpringBufferSize * sizeof(SpringElement), mSpringBuffer.get(), GL_DYNAMIC_DRAW);
+    // Anti-alias lines, which requires blending
+    mGLState.SetCapability(GL_LINE_SMOOTH, true);
+    mGLState.SetCapability(GL_BLEND, true);
+    mGLState.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     // Set line size
-    glLineWidth(0.1f * 2.0f * mCanvasHeight / mWorldHeight);
+    mGLState.SetLineWidth(0.1f * 2.0f * mCanvasHeight / mWorldHeight);
 
-    // Draw
-    glDrawElements(GL_LINES, static_cast<GLsizei>(2 * mSpringBufferSize), GL_UNSIGNED_INT, 0);
+    BeginTimedPass(RenderPass::Springs);
 
-    // Stop using program
-    glUseProgram(0);
+    size_t const indexSize = (GL_UNSIGNED_SHORT == mSpringIndexType) ? sizeof(uint16_t) : sizeof(uint32_t);
+
+    for (ShipIndexChunk const & chunk : mSpringChunks)
+    {
+        // Bind ship points, from the chunk's first point onwards, and springs buffer
+        BindShipPointsVAO(mSpringVAO, chunk.BasePoint);
+
+        if (!mUseVertexArrayObjects)
+        {
+            mGLState.BindElementArrayBuffer(*mSpringVBO);
+        }
+
+        // Draw
+        glDrawElements(GL_LINES, static_cast<GLsizei>(chunk.IndexCount), mSpringIndexType, (void*)(chunk.FirstIndex * indexSize));
+        ++mFrameCounters.DrawCalls;
+    }
+
+    EndTimedPass();
 }
 
 void RenderContext::RenderStressedSpringsStart(size_t maxSprings)
@@ -637,6 +1293,7 @@ void RenderContext::RenderStressedSpringsStart(size_t maxSprings)
         mStressedSpringBuffer.reset();
         mStressedSpringBuffer.reset(new SpringElement[maxSprings]);
         mStressedSpringBufferMaxSize = maxSprings;
+        TrackStagingAllocation(BufferType::StressedSprings, mStressedSpringBufferMaxSize * sizeof(SpringElement));
     }
 
     mStressedSpringBufferSize = 0u;
@@ -646,81 +1303,275 @@ void RenderContext::RenderStressedSpringsEnd()
 {
     assert(mStressedSpringBufferSize <= mStressedSpringBufferMaxSize);
 
-    // Use program
-    glUseProgram(*mStressedSpringShaderProgram);
+    // Upload stressed springs buffer, which is no caller's set anymore
+    SpecifyStressedSpringVBO(
+        reinterpret_cast<int const *>(mStressedSpringBuffer.get()),
+        mStressedSpringBufferSize,
+        mStressedSpringBufferSize);
 
-    // Set parameters
-    glUniform1f(mStressedSpringShaderAmbientLightIntensityParameter, mAmbientLightIntensity);
-    glUniformMatrix4fv(mStressedSpringShaderOrthoMatrixParameter, 1, GL_FALSE, &(mOrthoMatrix[0][0]));
+    mStressedSpringsVersion = 0u;
 
-    // Bind ship points
-    glBindBuffer(GL_ARRAY_BUFFER, *mShipPointVBO);
-    DescribeShipPointsVBO();
+    RenderStressedSprings();
+}
 
-    // Upload stressed springs buffer 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *mStressedSpringVBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, mStressedSpringBufferSize * sizeof(SpringElement), mStressedSpringBuffer.get(), GL_DYNAMIC_DRAW);
+void RenderContext::UploadStressedSprings(
+    uint64_t version,
+    int const * springIndices,
+    size_t springs)
+{
+    // Leave room for the set to grow
+    SpecifyStressedSpringVBO(
+        springIndices,
+        springs,
+        springs + springs / 2 + 64);
 
-    // Set line size
-    glLineWidth(0.1f * 2.0f * mCanvasHeight / mWorldHeight);
+    mStressedSpringsVersion = version;
+}
 
-    // Draw
-    glDrawElements(GL_LINES, static_cast<GLsizei>(2 * mStressedSpringBufferSize), GL_UNSIGNED_INT, 0);
+void RenderContext::UpdateStressedSprings(
+    int const * springIndices,
+    size_t springs,
+    size_t dirtyStart,
+    size_t dirtyEnd)
+{
+    assert(0u != mStressedSpringsVersion);
+    assert(dirtyStart <= dirtyEnd && dirtyEnd <= springs);
 
-    // Stop using program
-    glUseProgram(0);
+    if (springs > mStressedSpringVBOCapacity)
+    {
+        // Outgrown the store
+        UploadStressedSprings(mStressedSpringsVersion, springIndices, springs);
+        return;
+    }
+
+    if (dirtyStart < dirtyEnd)
+    {
+        if (mUseVertexArrayObjects)
+        {
+            // Make sure we don't replace the element buffer of whichever VAO is bound
+            mGLState.BindVertexArray(0);
+        }
+
+        mGLState.BindElementArrayBuffer(*mStressedSpringVBO);
+
+        glBufferSubData(
+            GL_ELEMENT_ARRAY_BUFFER,
+            dirtyStart * sizeof(SpringElement),
+            (dirtyEnd - dirtyStart) * sizeof(SpringElement),
+            springIndices + 2 * dirtyStart);
+        CountUpload(BufferType::StressedSprings, (dirtyEnd - dirtyStart) * sizeof(SpringElement));
+    }
+
+    mStressedSpringCount = springs;
 }
 
-void RenderContext::RenderShipTrianglesStart(size_t triangles)
+void RenderContext::RenderStressedSprings()
 {
-    if (triangles != mShipTriangleBufferMaxSize)
+    // Use program
+    mGLState.UseProgram(*mStressedSpringShaderProgram);
+
+    // Set parameters
+    SetCommonParameters(
+        mStressedSpringShaderParameterGenerations,
+        mStressedSpringShaderAmbientLightIntensityParameter,
+        mStressedSpringShaderOrthoMatrixParameter);
+
+    // Bind ship points and stressed springs buffer
+    BindShipPointsVAO(mStressedSpringVAO, 0u);
+
+    if (!mUseVertexArrayObjects)
     {
-        // Realloc
-        mShipTriangleBuffer.reset();
-        mShipTriangleBuffer.reset(new ShipTriangleElement[triangles]);
-        mShipTriangleBufferMaxSize = triangles;
+        mGLState.BindElementArrayBuffer(*mStressedSpringVBO);
     }
 
-    mShipTriangleBufferSize = 0u;
+    // Anti-alias lines, which requires blending
+    mGLState.SetCapability(GL_LINE_SMOOTH, true);
+    mGLState.SetCapability(GL_BLEND, true);
+    mGLState.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    // Set line size
+    mGLState.SetLineWidth(0.1f * 2.0f * mCanvasHeight / mWorldHeight);
+
+    BeginTimedPass(RenderPass::StressedSprings);
+
+    // Draw
+    glDrawElements(GL_LINES, static_cast<GLsizei>(2 * mStressedSpringCount), GL_UNSIGNED_INT, 0);
+    ++mFrameCounters.DrawCalls;
+
+    EndTimedPass();
 }
 
-void RenderContext::RenderShipTrianglesEnd()
+void RenderContext::RenderShipTriangles()
 {
-    assert(mShipTriangleBufferSize == mShipTriangleBufferMaxSize);
+    assert(0u != mShipTopologyVersion);
     
     // Use program
-    glUseProgram(*mShipTriangleShaderProgram);
+    mGLState.UseProgram(*mShipTriangleShaderProgram);
 
     // Set parameters
-    glUniformMatrix4fv(mShipTriangleShaderOrthoMatrixParameter, 1, GL_FALSE, &(mOrthoMatrix[0][0]));
+    SetCommonParameters(
+        mShipTriangleShaderParameterGenerations,
+        mShipTriangleShaderAmbientLightIntensityParameter,
+        mShipTriangleShaderOrthoMatrixParameter);
 
-    // Bind ship points
-    glBindBuffer(GL_ARRAY_BUFFER, *mShipPointVBO);
-    DescribeShipPointsVBO();
-    
-    // Upload ship triangles buffer 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *mShipTriangleVBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, mShipTriangleBufferSize * sizeof(ShipTriangleElement), mShipTriangleBuffer.get(), GL_DYNAMIC_DRAW);
+    // Triangles are opaque
+    mGLState.SetCapability(GL_BLEND, false);
 
-    // Draw
-    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(3 * mShipTriangleBufferSize), GL_UNSIGNED_INT, 0);
+    BeginTimedPass(RenderPass::ShipTriangles);
 
-    // Stop using program
-    glUseProgram(0);
+    size_t const indexSize = (GL_UNSIGNED_SHORT == mShipTriangleIndexType) ? sizeof(uint16_t) : sizeof(uint32_t);
+
+    for (ShipIndexChunk const & chunk : mShipTriangleChunks)
+    {
+        // Bind ship points, from the chunk's first point onwards, and ship triangles buffer
+        BindShipPointsVAO(mShipTriangleVAO, chunk.BasePoint);
+
+        if (!mUseVertexArrayObjects)
+        {
+            mGLState.BindElementArrayBuffer(*mShipTriangleVBO);
+        }
+
+        // Draw
+        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(chunk.IndexCount), mShipTriangleIndexType, (void*)(chunk.FirstIndex * indexSize));
+        ++mFrameCounters.DrawCalls;
+    }
+
+    EndTimedPass();
 }
 
-void RenderContext::RenderEnd()
+RenderContext::FrameCounters const & RenderContext::RenderEnd()
 {
+    // This frame's draws are the last ones reading from the current stream segments
+    mShipPointPositionStream->FenceCurrentSegment();
+    mShipPointColourStream->FenceCurrentSegment();
+
     glFlush();
+
+    mFrameCounters.ProgramSwitches = static_cast<size_t>(mGLState.GetStatistics().ProgramSwitches);
+    mFrameCounters.StateChanges = static_cast<size_t>(mGLState.GetStatistics().Issued);
+    mLastFrameCounters = mFrameCounters;
+
+    for (size_t p = 0; p < static_cast<size_t>(RenderPass::_Count); ++p)
+    {
+        mAverageCpuPassTimes[p] += (mCpuPassTimes[p] - mAverageCpuPassTimes[p]) / 32.0f;
+    }
+
+    // After the counters and timings, so as not to skew them
+    if (mShowPerformanceOverlay)
+    {
+        RenderPerformanceOverlay();
+    }
+
+    return mLastFrameCounters;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////
 
+void RenderContext::RenderPerformanceOverlay()
+{
+    //
+    // Text
+    //
+
+    mPerformanceOverlay.ClearText();
+
+    char line[128];
+
+    snprintf(line, sizeof(line), "FRAME %.2f MS   DRAWS %zu   UPLOADED %.1f KB",
+        mAverageFrameTime,
+        mLastFrameCounters.DrawCalls,
+        static_cast<float>(mLastFrameCounters.GetTotalBytesUploaded()) / 1024.0f);
+    mPerformanceOverlay.AddText(0, 0, line);
+
+    snprintf(line, sizeof(line), "PROGRAMS %zu   UNIFORMS %zu   STATE CHANGES %zu",
+        mLastFrameCounters.ProgramSwitches,
+        mLastFrameCounters.UniformUploads,
+        mLastFrameCounters.StateChanges);
+    mPerformanceOverlay.AddText(0, 1, line);
+
+    snprintf(line, sizeof(line), "BUFFERS CPU %.1f KB (PEAK %.1f)   GPU %.1f KB (PEAK %.1f)",
+        static_cast<float>(mTotalBufferMemory.StagingBytes) / 1024.0f,
+        static_cast<float>(mTotalBufferMemory.PeakStagingBytes) / 1024.0f,
+        static_cast<float>(mTotalBufferMemory.GpuBytes) / 1024.0f,
+        static_cast<float>(mTotalBufferMemory.PeakGpuBytes) / 1024.0f);
+    mPerformanceOverlay.AddText(0, 2, line);
+
+    mPerformanceOverlay.AddText(0, 4, "PASS               CPU MS   GPU MS", PerformanceOverlay::HeaderColour);
+
+    for (size_t p = 0; p < static_cast<size_t>(RenderPass::_Count); ++p)
+    {
+        RenderPass const pass = static_cast<RenderPass>(p);
+
+        if (mGpuPassTimer->IsSupported())
+        {
+            snprintf(line, sizeof(line), "%-18s %6.2f   %6.2f",
+                GetRenderPassName(pass),
+                GetAverageCpuPassTime(pass),
+                GetAverageGpuPassTime(pass));
+        }
+        else
+        {
+            snprintf(line, sizeof(line), "%-18s %6.2f      N/A",
+                GetRenderPassName(pass),
+                GetAverageCpuPassTime(pass));
+        }
+
+        mPerformanceOverlay.AddText(0, 5 + p, line);
+    }
+
+    std::vector<PerformanceOverlay::Vertex> const & vertices = mPerformanceOverlay.BuildVertices();
+
+    //
+    // Draw
+    //
+
+    // Use program
+    mGLState.UseProgram(*mOverlayShaderProgram);
+
+    // Set parameters; the canvas size only changes together with the ortho matrix
+    if (mOverlayShaderParameterGenerations.OrthoMatrix != mOrthoMatrixGeneration)
+    {
+        glUniform2f(mOverlayShaderCanvasSizeParameter, static_cast<float>(mCanvasWidth), static_cast<float>(mCanvasHeight));
+        mOverlayShaderParameterGenerations.OrthoMatrix = mOrthoMatrixGeneration;
+    }
+
+    if (mUseVertexArrayObjects)
+    {
+        mGLState.BindVertexArray(*mOverlayVAO);
+        mGLState.BindArrayBuffer(*mOverlayVBO);
+    }
+    else
+    {
+        mGLState.BindArrayBuffer(*mOverlayVBO);
+
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(PerformanceOverlay::Vertex), (void*)offsetof(PerformanceOverlay::Vertex, x));
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(PerformanceOverlay::Vertex), (void*)offsetof(PerformanceOverlay::Vertex, u));
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(PerformanceOverlay::Vertex), (void*)offsetof(PerformanceOverlay::Vertex, r));
+        glEnableVertexAttribArray(2);
+    }
+
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(PerformanceOverlay::Vertex), vertices.data(), GL_STREAM_DRAW);
+
+    // Nothing else uses textures, hence we don't track them
+    glBindTexture(GL_TEXTURE_2D, *mOverlayFontTexture);
+
+    // The panel is translucent, and so are the glyphs' backgrounds
+    mGLState.SetCapability(GL_BLEND, true);
+    mGLState.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    // Draw
+    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertices.size()));
+}
+
 void RenderContext::CompileShader(
     char const * shaderSource,
     GLenum shaderType,
     OpenGLShaderProgram const & shaderProgram)
 {
+    PROFILE_SCOPE("CompileShader");
+
     // Compile
     GLuint shader = glCreateShader(shaderType);
     glShaderSource(shader, 1, &shaderSource, NULL);
@@ -747,6 +1598,8 @@ void RenderContext::LinkProgram(
     OpenGLShaderProgram const & shaderProgram,
     std::string const & programName)
 {
+    PROFILE_SCOPE("LinkProgram");
+
     glLinkProgram(*shaderProgram);
 
     // Check
@@ -773,14 +1626,320 @@ GLint RenderContext::GetParameterLocation(
     return parameterLocation;
 }
 
-void RenderContext::DescribeShipPointsVBO()
+void RenderContext::DescribeShipPointsVBO(size_t basePoint)
 {
+    // The data lives in each stream's current segment, the colours' in three planes
+    size_t const positionOffset = mShipPointPositionStream->GetCurrentSegmentOffset() + basePoint * sizeof(ShipPointPositionElement);
+    size_t const colourOffset = mShipPointColourStream->GetCurrentSegmentOffset() + basePoint * sizeof(ShipPointColourElement);
+    size_t const waterOffset = mShipPointColourStream->GetCurrentSegmentOffset() + mShipPointColourCount * sizeof(ShipPointColourElement) + basePoint * sizeof(float);
+    size_t const lightOffset = waterOffset + mShipPointColourCount * sizeof(float);
+
     // Position    
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, (2 + 3) * sizeof(float), (void*)(0));
+    mGLState.BindArrayBuffer(mShipPointPositionStream->GetVBO());
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(ShipPointPositionElement), (void*)(positionOffset));
     glEnableVertexAttribArray(0);
     // Color    
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, (2 + 3) * sizeof(float), (void*)(2 * sizeof(float)));
+    mGLState.BindArrayBuffer(mShipPointColourStream->GetVBO());
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(ShipPointColourElement), (void*)(colourOffset));
+    glEnableVertexAttribArray(1);
+    // Water
+    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)(waterOffset));
+    glEnableVertexAttribArray(2);
+    // Light
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)(lightOffset));
+    glEnableVertexAttribArray(3);
+
+    mFrameCounters.AttributeSetups += 8;
+}
+
+void RenderContext::CreateShipPointsVAO(
+    ShipPointsVAO & shipPointsVAO,
+    GLuint elementVBO)
+{
+    if (!mUseVertexArrayObjects)
+    {
+        return;
+    }
+
+    GLuint tmpVAO;
+    glGenVertexArrays(1, &tmpVAO);
+    shipPointsVAO.VAO = tmpVAO;
+
+    glBindVertexArray(tmpVAO);
+
+    // The attribute pointers are only known once the streams have been uploaded
+    glEnableVertexAttribArray(0);
     glEnableVertexAttribArray(1);
+    glEnableVertexAttribArray(2);
+    glEnableVertexAttribArray(3);
+
+    if (0u != elementVBO)
+    {
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, elementVBO);
+    }
+
+    glBindVertexArray(0);
+}
+
+void RenderContext::BindShipPointsVAO(
+    ShipPointsVAO & shipPointsVAO,
+    size_t basePoint)
+{
+    if (!mUseVertexArrayObjects)
+    {
+        DescribeShipPointsVBO(basePoint);
+        return;
+    }
+
+    mGLState.BindVertexArray(*shipPointsVAO.VAO);
+
+    // Four pointers and four enables, which is what DescribeShipPointsVBO() would cost
+    size_t attributeSetupCalls = 0u;
+
+    // Only re-point the attributes whose stream has moved to another segment,
+    // or to another base point, since this VAO was last bound
+
+    size_t const positionOffset = mShipPointPositionStream->GetCurrentSegmentOffset() + basePoint * sizeof(ShipPointPositionElement);
+    if (positionOffset != shipPointsVAO.PositionOffset)
+    {
+        mGLState.BindArrayBuffer(mShipPointPositionStream->GetVBO());
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(ShipPointPositionElement), (void*)(positionOffset));
+        attributeSetupCalls += 1;
+
+        shipPointsVAO.PositionOffset = positionOffset;
+    }
+
+    // The water and light planes also move with the number of points
+    size_t const colourOffset = mShipPointColourStream->GetCurrentSegmentOffset() + basePoint * sizeof(ShipPointColourElement);
+    size_t const waterOffset = mShipPointColourStream->GetCurrentSegmentOffset() + mShipPointColourCount * sizeof(ShipPointColourElement) + basePoint * sizeof(float);
+    size_t const lightOffset = waterOffset + mShipPointColourCount * sizeof(float);
+    if (colourOffset != shipPointsVAO.ColourOffset
+        || waterOffset != shipPointsVAO.WaterOffset
+        || lightOffset != shipPointsVAO.LightOffset)
+    {
+        mGLState.BindArrayBuffer(mShipPointColourStream->GetVBO());
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(ShipPointColourElement), (void*)(colourOffset));
+        glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)(waterOffset));
+        glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)(lightOffset));
+        attributeSetupCalls += 3;
+
+        shipPointsVAO.ColourOffset = colourOffset;
+        shipPointsVAO.WaterOffset = waterOffset;
+        shipPointsVAO.LightOffset = lightOffset;
+    }
+
+    mAttributeSetupCallsSaved += 8 - attributeSetupCalls;
+    mFrameCounters.AttributeSetups += attributeSetupCalls;
+}
+
+void RenderContext::CommitShipPointPositions(size_t points)
+{
+    mGLState.InvalidateArrayBuffer();
+    CountUpload(BufferType::ShipPointPositions, points * sizeof(ShipPointPositionElement));
+    TrackStreamMemory(BufferType::ShipPointPositions, *mShipPointPositionStream);
+
+    if (points != mShipPointColourCount)
+    {
+        // The colours we have are for a different set of points
+        mAreShipPointColoursDirty = true;
+    }
+
+    mShipPointPositionCount = points;
+    mAreShipPointPositionsDirty = false;
+}
+
+void RenderContext::CommitShipPointColours(size_t points)
+{
+    mGLState.InvalidateArrayBuffer();
+    CountUpload(BufferType::ShipPointColours, points * ShipPointColourBytes);
+    TrackStreamMemory(BufferType::ShipPointColours, *mShipPointColourStream);
+
+    if (points != mShipPointPositionCount)
+    {
+        // The positions we have are for a different set of points
+        mAreShipPointPositionsDirty = true;
+    }
+
+    mShipPointColourCount = points;
+    mAreShipPointColoursDirty = false;
+}
+
+void RenderContext::BeginShipTopology(
+    uint64_t version,
+    size_t points)
+{
+    mShipTopologyVersion = version;
+
+    // Go for 16-bit indices whenever we can
+    GLenum const indexType = (points <= 0x10000u || mUseShipIndexChunks) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    mSpringIndexType = indexType;
+    mShipTriangleIndexType = indexType;
+}
+
+void RenderContext::UploadShipTopologyIndices(
+    int const * springIndices,
+    size_t springs,
+    int const * triangleIndices,
+    size_t triangles)
+{
+    if (mUseVertexArrayObjects)
+    {
+        // Make sure we don't replace the element buffer of whichever VAO is bound
+        mGLState.BindVertexArray(0);
+    }
+
+    // Upload springs buffer 
+    UploadShipIndices(
+        springIndices,
+        springs,
+        2,
+        *mSpringVBO,
+        BufferType::Springs,
+        mSpringIndexType,
+        mSpringChunks);
+
+    // Upload ship triangles buffer 
+    UploadShipIndices(
+        triangleIndices,
+        triangles,
+        3,
+        *mShipTriangleVBO,
+        BufferType::ShipTriangles,
+        mShipTriangleIndexType,
+        mShipTriangleChunks);
+}
+
+void RenderContext::SpecifyStressedSpringVBO(
+    int const * springIndices,
+    size_t springs,
+    size_t capacity)
+{
+    assert(springs <= capacity);
+
+    if (mUseVertexArrayObjects)
+    {
+        // Make sure we don't replace the element buffer of whichever VAO is bound
+        mGLState.BindVertexArray(0);
+    }
+
+    mGLState.BindElementArrayBuffer(*mStressedSpringVBO);
+
+    if (capacity == springs)
+    {
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, springs * sizeof(SpringElement), springIndices, GL_DYNAMIC_DRAW);
+    }
+    else
+    {
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, capacity * sizeof(SpringElement), nullptr, GL_DYNAMIC_DRAW);
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, springs * sizeof(SpringElement), springIndices);
+    }
+
+    CountUpload(BufferType::StressedSprings, springs * sizeof(SpringElement));
+    TrackGpuAllocation(BufferType::StressedSprings, capacity * sizeof(SpringElement));
+
+    mStressedSpringCount = springs;
+    mStressedSpringVBOCapacity = capacity;
+}
+
+void RenderContext::UploadShipIndices(
+    int const * indices,
+    size_t primitiveCount,
+    size_t indicesPerPrimitive,
+    GLuint elementVBO,
+    BufferType bufferType,
+    GLenum & indexType,
+    std::vector<ShipIndexChunk> & chunks)
+{
+    mGLState.BindElementArrayBuffer(elementVBO);
+
+    if (GL_UNSIGNED_SHORT == indexType)
+    {
+        std::vector<uint16_t> chunkIndices;
+        if (MakeShipIndexChunks(indices, primitiveCount, indicesPerPrimitive, chunkIndices, chunks))
+        {
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, chunkIndices.size() * sizeof(uint16_t), chunkIndices.data(), GL_STATIC_DRAW);
+            CountUpload(bufferType, chunkIndices.size() * sizeof(uint16_t));
+            TrackGpuAllocation(bufferType, chunkIndices.size() * sizeof(uint16_t));
+            return;
+        }
+
+        // Some primitive spans more points than 16 bits may reach
+        indexType = GL_UNSIGNED_INT;
+    }
+
+    // Upload as-is, in one chunk
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, primitiveCount * indicesPerPrimitive * sizeof(int), indices, GL_STATIC_DRAW);
+    CountUpload(bufferType, primitiveCount * indicesPerPrimitive * sizeof(int));
+    TrackGpuAllocation(bufferType, primitiveCount * indicesPerPrimitive * sizeof(int));
+
+    chunks.clear();
+    if (primitiveCount > 0)
+    {
+        chunks.emplace_back(0u, 0u, primitiveCount * indicesPerPrimitive);
+    }
+}
+
+void RenderContext::SetCommonParameters(
+    ProgramParameterGenerations & programParameterGenerations,
+    GLint ambientLightIntensityParameter,
+    GLint orthoMatrixParameter)
+{
+    // Uniforms stick with the program, hence we only need to upload what
+    // changed since the last time this program was used
+
+    if (programParameterGenerations.AmbientLightIntensity != mAmbientLightIntensityGeneration)
+    {
+        glUniform1f(ambientLightIntensityParameter, mAmbientLightIntensity);
+        programParameterGenerations.AmbientLightIntensity = mAmbientLightIntensityGeneration;
+        ++mFrameCounters.UniformUploads;
+    }
+
+    if (programParameterGenerations.OrthoMatrix != mOrthoMatrixGeneration)
+    {
+        glUniformMatrix4fv(orthoMatrixParameter, 1, GL_FALSE, &(mOrthoMatrix[0][0]));
+        programParameterGenerations.OrthoMatrix = mOrthoMatrixGeneration;
+        ++mFrameCounters.UniformUploads;
+    }
+}
+
+void RenderContext::UpdateBufferMemory(
+    BufferType bufferType,
+    size_t stagingBytes,
+    uint64_t newStagingAllocations,
+    size_t gpuBytes,
+    uint64_t newGpuAllocations)
+{
+    BufferMemory & memory = mBufferMemory[static_cast<size_t>(bufferType)];
+
+    mTotalBufferMemory.StagingBytes = mTotalBufferMemory.StagingBytes - memory.StagingBytes + stagingBytes;
+    mTotalBufferMemory.PeakStagingBytes = std::max(mTotalBufferMemory.PeakStagingBytes, mTotalBufferMemory.StagingBytes);
+    mTotalBufferMemory.StagingAllocations += newStagingAllocations;
+    mTotalBufferMemory.GpuBytes = mTotalBufferMemory.GpuBytes - memory.GpuBytes + gpuBytes;
+    mTotalBufferMemory.PeakGpuBytes = std::max(mTotalBufferMemory.PeakGpuBytes, mTotalBufferMemory.GpuBytes);
+    mTotalBufferMemory.GpuAllocations += newGpuAllocations;
+
+    memory.StagingBytes = stagingBytes;
+    memory.PeakStagingBytes = std::max(memory.PeakStagingBytes, stagingBytes);
+    memory.StagingAllocations += newStagingAllocations;
+    memory.GpuBytes = gpuBytes;
+    memory.PeakGpuBytes = std::max(memory.PeakGpuBytes, gpuBytes);
+    memory.GpuAllocations += newGpuAllocations;
+}
+
+void RenderContext::TrackStreamMemory(
+    BufferType bufferType,
+    StreamingBuffer const & stream)
+{
+    // The stream is the only owner of the buffer's memory, hence its allocation
+    // counts are the buffer's
+    BufferMemory const & memory = GetBufferMemory(bufferType);
+
+    UpdateBufferMemory(
+        bufferType,
+        stream.GetStagingBufferSize(),
+        stream.GetStatistics().StagingAllocations - memory.StagingAllocations,
+        stream.GetBufferSize(),
+        stream.GetStatistics().BufferAllocations - memory.GpuAllocations);
 }
 
 void RenderContext::CalculateOrthoMatrix()
@@ -795,6 +1954,8 @@ void RenderContext::CalculateOrthoMatrix()
     mOrthoMatrix[3][1] = 2.0f * mCamY / mWorldHeight; // TBD: probably it has to be minus
     mOrthoMatrix[3][2] = -(zFar + zNear) / (zFar - zNear);
     mOrthoMatrix[3][3] = 1.0f;
+
+    ++mOrthoMatrixGeneration;
 }
 
 void RenderContext::CalculateWorldCoordinates()
@@ -5,16 +5,133 @@
 ***************************************************************************************/
 #pragma once
 
+#include "GpuPassTimer.h"
+#include "OpenGLStateTracker.h"
 #include "OpenGLTest.h"
+#include "PerformanceOverlay.h"
+#include "ShipIndexChunks.h"
+#include "StreamingBuffer.h"
 #include "Vectors.h"
 
 #include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
 
 class RenderContext
 {
+public:
+
+    // The passes whose GPU time is measured
+    enum class RenderPass : size_t
+    {
+        Land = 0,
+        Water,
+        ShipPoints,
+        Springs,
+        StressedSprings,
+        ShipTriangles,
+
+        _Count
+    };
+
+    static char const * GetRenderPassName(RenderPass pass);
+
+    // The buffers whose uploads and memory are counted
+    enum class BufferType : size_t
+    {
+        Land = 0,
+        Water,
+        WaterSurface,
+        ShipPointPositions,
+        ShipPointColours,
+        Springs,
+        ShipTriangles,
+        StressedSprings,
+
+        _Count
+    };
+
+    static char const * GetBufferTypeName(BufferType bufferType);
+
+    /*
+     * The driver calls made, and the data uploaded, from RenderStart() to RenderEnd().
+     */
+    struct FrameCounters
+    {
+        size_t DrawCalls;
+        size_t ProgramSwitches;
+        size_t StateChanges;
+        size_t UniformUploads;
+        size_t AttributeSetups;
+        uint64_t BytesUploaded[static_cast<size_t>(BufferType::_Count)];
+
+        FrameCounters()
+            : DrawCalls(0u)
+            , ProgramSwitches(0u)
+            , StateChanges(0u)
+            , UniformUploads(0u)
+            , AttributeSetups(0u)
+            , BytesUploaded()
+        {}
+
+        uint64_t GetTotalBytesUploaded() const
+        {
+            uint64_t totalBytesUploaded = 0u;
+            for (uint64_t bytesUploaded : BytesUploaded)
+            {
+                totalBytesUploaded += bytesUploaded;
+            }
+
+            return totalBytesUploaded;
+        }
+
+        FrameCounters & operator+=(FrameCounters const & other)
+        {
+            DrawCalls += other.DrawCalls;
+            ProgramSwitches += other.ProgramSwitches;
+            StateChanges += other.StateChanges;
+            UniformUploads += other.UniformUploads;
+            AttributeSetups += other.AttributeSetups;
+            for (size_t b = 0; b < static_cast<size_t>(BufferType::_Count); ++b)
+            {
+                BytesUploaded[b] += other.BytesUploaded[b];
+            }
+
+            return *this;
+        }
+    };
+
+    /*
+     * The memory held for a buffer, in bytes: by its CPU staging copy and by its GL
+     * buffer object. Peaks are since the RenderContext was created.
+     *
+     * The allocation counts include the GL stores that are re-specified every frame,
+     * hence they keep growing with frames for some buffers; one growing faster than
+     * its uploads reveals realloc churn.
+     */
+    struct BufferMemory
+    {
+        size_t StagingBytes;
+        size_t PeakStagingBytes;
+        uint64_t StagingAllocations;
+        size_t GpuBytes;
+        size_t PeakGpuBytes;
+        uint64_t GpuAllocations;
+
+        BufferMemory()
+            : StagingBytes(0u)
+            , PeakStagingBytes(0u)
+            , StagingAllocations(0u)
+            , GpuBytes(0u)
+            , PeakGpuBytes(0u)
+            , GpuAllocations(0u)
+        {}
+    };
+
 public:
 
     RenderContext();
@@ -83,7 +200,12 @@ public:
 
     void SetAmbientLightIntensity(float intensity)
     {
-        mAmbientLightIntensity = intensity;
+        if (intensity != mAmbientLightIntensity)
+        {
+            mAmbientLightIntensity = intensity;
+
+            ++mAmbientLightIntensityGeneration;
+        }
     }
 
     bool GetShowStress() const
@@ -126,6 +248,101 @@ public:
         mDrawPointsOnly = drawPointsOnly;
     }
 
+    StreamingBuffer::Statistics GetShipPointStreamStatistics() const
+    {
+        assert(!!mShipPointPositionStream && !!mShipPointColourStream);
+
+        StreamingBuffer::Statistics statistics;
+        statistics.BytesStreamed = mShipPointPositionStream->GetStatistics().BytesStreamed + mShipPointColourStream->GetStatistics().BytesStreamed;
+        statistics.Stalls = mShipPointPositionStream->GetStatistics().Stalls + mShipPointColourStream->GetStatistics().Stalls;
+        statistics.BufferAllocations = mShipPointPositionStream->GetStatistics().BufferAllocations + mShipPointColourStream->GetStatistics().BufferAllocations;
+        statistics.StagingAllocations = mShipPointPositionStream->GetStatistics().StagingAllocations + mShipPointColourStream->GetStatistics().StagingAllocations;
+        return statistics;
+    }
+
+    bool IsUsingVertexArrayObjects() const
+    {
+        return mUseVertexArrayObjects;
+    }
+
+    /*
+     * The number of glVertexAttribPointer/glEnableVertexAttribArray calls that the
+     * vertex array objects have spared us since the start of the current frame.
+     */
+    size_t GetAttributeSetupCallsSaved() const
+    {
+        return mAttributeSetupCallsSaved;
+    }
+
+    /*
+     * The number of state changes issued to, and elided from, OpenGL since the
+     * start of the current frame.
+     */
+    OpenGLStateTracker::Statistics const & GetStateChangeStatistics() const
+    {
+        return mGLState.GetStatistics();
+    }
+
+    bool IsGpuTimingSupported() const
+    {
+        return mGpuPassTimer->IsSupported();
+    }
+
+    /*
+     * The average GPU time of the pass over the most recent frames, in milliseconds;
+     * the results lag a few frames behind, and are zero without timer queries.
+     */
+    float GetAverageGpuPassTime(RenderPass pass) const
+    {
+        return mGpuPassTimer->GetAveragePassTime(static_cast<size_t>(pass));
+    }
+
+    /*
+     * The average CPU time of the pass over the most recent frames, in milliseconds;
+     * a pass's CPU time runs from the end of the previous pass - or RenderStart() -
+     * to the end of its own draws, hence it includes the caller's uploads for it.
+     */
+    float GetAverageCpuPassTime(RenderPass pass) const
+    {
+        return mAverageCpuPassTimes[static_cast<size_t>(pass)];
+    }
+
+    /*
+     * The counters of the last frame that went through RenderEnd().
+     */
+    FrameCounters const & GetLastFrameCounters() const
+    {
+        return mLastFrameCounters;
+    }
+
+    BufferMemory const & GetBufferMemory(BufferType bufferType) const
+    {
+        return mBufferMemory[static_cast<size_t>(bufferType)];
+    }
+
+    /*
+     * The memory of all buffers together; its peaks are those of the totals, which
+     * may be less than the sum of the buffers' peaks.
+     */
+    BufferMemory const & GetTotalBufferMemory() const
+    {
+        return mTotalBufferMemory;
+    }
+
+    bool GetShowPerformanceOverlay() const
+    {
+        return mShowPerformanceOverlay;
+    }
+
+    /*
+     * The overlay is drawn at the end of each frame, after the frame's counters and
+     * timings have been taken, with a single draw call.
+     */
+    void SetShowPerformanceOverlay(bool showPerformanceOverlay)
+    {
+        mShowPerformanceOverlay = showPerformanceOverlay;
+    }
+
     inline vec2 Screen2World(vec2 const & screenCoordinates)
     {
         return vec2(
@@ -148,10 +365,26 @@ public:
     //
     // Land
     //
+    // The land strip is static: it's only re-built when the terrain or its sampling
+    // change, which the caller detects by means of the version stamp. The land may
+    // also be invalidated explicitly, forcing the caller to re-build it.
+    //
+
+    uint64_t GetLandVersion() const
+    {
+        return mLandVersion;
+    }
 
-    void RenderLandStart(size_t slices);
+    void InvalidateLand()
+    {
+        mLandVersion = 0u;
+    }
 
-    inline void RenderLand(
+    void UploadLandStart(
+        uint64_t version,
+        size_t slices);
+
+    inline void UploadLand(
         float x,
         float bottom,
         float top)
@@ -168,7 +401,9 @@ public:
         ++mLandBufferSize;
     }
 
-    void RenderLandEnd();
+    void UploadLandEnd();
+
+    void RenderLand();
 
 
     //
@@ -197,44 +432,191 @@ public:
     void RenderWaterEnd();
 
 
+    //
+    // Water surface
+    //
+    // An alternative to the above, where the water grid is uploaded once and the
+    // surface is displaced by the vertex shader according to the time; the waves
+    // match MainFrame::GetWaterHeight within the precision of the GPU's sin().
+    //
+
+    uint64_t GetWaterSurfaceVersion() const
+    {
+        return mWaterSurfaceVersion;
+    }
+
+    void InvalidateWaterSurface()
+    {
+        mWaterSurfaceVersion = 0u;
+    }
+
+    void UploadWaterSurfaceStart(
+        uint64_t version,
+        size_t slices);
+
+    inline void UploadWaterSurface(
+        float x,
+        float bottom)
+    {
+        assert(mWaterSurfaceBufferSize + 1u <= mWaterSurfaceBufferMaxSize);
+
+        WaterSurfaceElement * waterSurfaceElement = &(mWaterSurfaceBuffer[mWaterSurfaceBufferSize]);
+
+        // The top vertex is displaced by the waves, the bottom one is not
+        waterSurfaceElement->x1 = x;
+        waterSurfaceElement->y1 = 0.0f;
+        waterSurfaceElement->displacement1 = 1.0f;
+        waterSurfaceElement->x2 = x;
+        waterSurfaceElement->y2 = bottom;
+        waterSurfaceElement->displacement2 = 0.0f;
+
+        ++mWaterSurfaceBufferSize;
+    }
+
+    void UploadWaterSurfaceEnd();
+
+    void RenderWaterSurface(
+        float time,
+        float waveHeight);
+
+
     //
     // Ship Points
     //
 
-    void UploadShipPointStart(size_t points);
+    // Positions and colours are separate streams, each only needing an upload when it is dirty.
+    // A stream becomes dirty when invalidated by the caller, or when the other stream is
+    // uploaded with a different number of points.
+    //
+    // Either stream may be uploaded a point at a time, between the *Start and *End calls,
+    // or all at once from arrays the caller keeps in the streams' own layout - positions
+    // as an array of vec2f, and colours as planes of vec3f colours, of waters and of lights.
+    // The latter only costs one memcpy into the stream, or none when the stream falls back
+    // to glBufferSubData.
+
+    bool AreShipPointPositionsDirty() const
+    {
+        return mAreShipPointPositionsDirty;
+    }
+
+    void InvalidateShipPointPositions()
+    {
+        mAreShipPointPositionsDirty = true;
+    }
+
+    void UploadShipPointPositionsStart(size_t points);
 
-    inline void UploadShipPoint(
+    inline void UploadShipPointPosition(
         float x,
-        float y,
+        float y)
+    {
+        assert(mShipPointPositionBufferSize + 1u <= mShipPointPositionBufferMaxSize);
+
+        ShipPointPositionElement * shipPointPositionElement = &(mShipPointPositionBuffer[mShipPointPositionBufferSize]);
+
+        shipPointPositionElement->x = x;
+        shipPointPositionElement->y = y;
+
+        ++mShipPointPositionBufferSize;
+    }
+
+    void UploadShipPointPositionsEnd();
+
+    void UploadShipPointPositions(
+        vec2f const * positions,
+        size_t points);
+
+    bool AreShipPointColoursDirty() const
+    {
+        return mAreShipPointColoursDirty;
+    }
+
+    void InvalidateShipPointColours()
+    {
+        mAreShipPointColoursDirty = true;
+    }
+
+    void UploadShipPointColoursStart(size_t points);
+
+    inline void UploadShipPointColour(
         float r,
         float g,
-        float b)
+        float b,
+        float water,
+        float light)
     {
-        assert(mShipPointBufferSize + 1u <= mShipPointBufferMaxSize);
+        assert(mShipPointColourBufferSize + 1u <= mShipPointColourBufferMaxSize);
+
+        ShipPointColourElement * shipPointColourElement = &(mShipPointColourBuffer[mShipPointColourBufferSize]);
 
-        ShipPointElement * shipPointElement = &(mShipPointBuffer[mShipPointBufferSize]);
+        shipPointColourElement->r = r;
+        shipPointColourElement->g = g;
+        shipPointColourElement->b = b;
 
-        shipPointElement->x = x;
-        shipPointElement->y = y;
-        shipPointElement->r = r;
-        shipPointElement->g = g;
-        shipPointElement->b = b;
+        mShipPointWaterBuffer[mShipPointColourBufferSize] = water;
+        mShipPointLightBuffer[mShipPointColourBufferSize] = light;
 
-        ++mShipPointBufferSize;
+        ++mShipPointColourBufferSize;
     }
 
-    void UploadShipPointEnd();
+    void UploadShipPointColoursEnd();
+
+    void UploadShipPointColours(
+        vec3f const * colours,
+        float const * waters,
+        float const * lights,
+        size_t points);
 
     void RenderShipPoints();
 
 
     //
-    // Springs
+    // Ship topology
     //
+    // Springs and triangles only change when the ship's structure changes, hence
+    // they're uploaded once into static buffers and drawn as-is on subsequent frames.
+    // The version stamp tells the caller whether the uploaded topology is current.
+    //
+    // Indices are stored as 16-bit when the ship has less than 64K points, and as
+    // 32-bit otherwise - unless index chunks are enabled, in which case the springs
+    // and triangles are split into runs that each reference less than 64K points,
+    // drawn with the ship point attributes offset to the start of each run.
+    //
+    // As with the points, the topology may also be uploaded all at once from the
+    // caller's arrays of point indices, two per spring and three per triangle; the
+    // 32-bit indices are then handed as-is to glBufferData.
+    //
+
+    uint64_t GetShipTopologyVersion() const
+    {
+        return mShipTopologyVersion;
+    }
 
-    void RenderSpringsStart(size_t springs);
+    void InvalidateShipTopology()
+    {
+        mShipTopologyVersion = 0u;
+    }
+
+    bool GetUseShipIndexChunks() const
+    {
+        return mUseShipIndexChunks;
+    }
 
-    inline void RenderSpring(
+    void SetUseShipIndexChunks(bool useShipIndexChunks)
+    {
+        mUseShipIndexChunks = useShipIndexChunks;
+
+        // Force the caller to re-upload the topology
+        mShipTopologyVersion = 0u;
+    }
+
+    void UploadShipTopologyStart(
+        uint64_t version,
+        size_t points,
+        size_t springs,
+        size_t triangles);
+
+    inline void UploadShipSpring(
         int shipPointIndex1,
         int shipPointIndex2)
     {
@@ -248,8 +630,79 @@ public:
         ++mSpringBufferSize;
     }
 
-    void RenderSpringsEnd();
+    inline void UploadShipTriangle(
+        int shipPointIndex1,
+        int shipPointIndex2,
+        int shipPointIndex3)
+    {
+        assert(mShipTriangleBufferSize + 1u <= mShipTriangleBufferMaxSize);
 
+        ShipTriangleElement * shipTriangleElement = &(mShipTriangleBuffer[mShipTriangleBufferSize]);
+
+        shipTriangleElement->shipPointIndex1 = shipPointIndex1;
+        shipTriangleElement->shipPointIndex2 = shipPointIndex2;
+        shipTriangleElement->shipPointIndex3 = shipPointIndex3;
+
+        ++mShipTriangleBufferSize;
+    }
+
+    void UploadShipTopologyEnd();
+
+    void UploadShipTopology(
+        uint64_t version,
+        size_t points,
+        int const * springIndices,
+        size_t springs,
+        int const * triangleIndices,
+        size_t triangles);
+
+
+    //
+    // Springs
+    //
+
+    void RenderSprings();
+
+
+    //
+    // Stressed springs
+    //
+    // Either re-written in full every frame, between RenderStressedSpringsStart() and
+    // RenderStressedSpringsEnd(), or kept by the caller as a set - an array of point
+    // indices, two per spring - which is uploaded once and then only updated where it
+    // changed: UpdateStressedSprings() re-uploads the dirty range of the set, and a
+    // frame in which the set didn't change costs no upload at all.
+    //
+    // The version stamp tells the caller whether the uploaded set is its own; it's
+    // reset by the full re-writes.
+    //
+
+    uint64_t GetStressedSpringsVersion() const
+    {
+        return mStressedSpringsVersion;
+    }
+
+    void InvalidateStressedSprings()
+    {
+        mStressedSpringsVersion = 0u;
+    }
+
+    void UploadStressedSprings(
+        uint64_t version,
+        int const * springIndices,
+        size_t springs);
+
+    /*
+     * The set as it is now, of which only the springs from dirtyStart (included)
+     * to dirtyEnd (excluded) changed since the last upload or update.
+     */
+    void UpdateStressedSprings(
+        int const * springIndices,
+        size_t springs,
+        size_t dirtyStart,
+        size_t dirtyEnd);
+
+    void RenderStressedSprings();
 
     void RenderStressedSpringsStart(size_t maxSprings);
 
@@ -274,27 +727,12 @@ public:
     // Ship triangles
     //
 
-    void RenderShipTrianglesStart(size_t triangles);
-
-    inline void RenderShipTriangle(
-        int shipPointIndex1,
-        int shipPointIndex2,
-        int shipPointIndex3)
-    {
-        assert(mShipTriangleBufferSize + 1u <= mShipTriangleBufferMaxSize);
-
-        ShipTriangleElement * shipTriangleElement = &(mShipTriangleBuffer[mShipTriangleBufferSize]);
-
-        shipTriangleElement->shipPointIndex1 = shipPointIndex1;
-        shipTriangleElement->shipPointIndex2 = shipPointIndex2;
-        shipTriangleElement->shipPointIndex3 = shipPointIndex3;
-
-        ++mShipTriangleBufferSize;
-    }
+    void RenderShipTriangles();
 
-    void RenderShipTrianglesEnd();
-
-    void RenderEnd();
+    /*
+     * Returns the frame's counters, which stay valid until the next RenderEnd().
+     */
+    FrameCounters const & RenderEnd();
 
 private:
 
@@ -355,8 +793,64 @@ private:
         }
     };
 
+    struct OpenGLVAODeleter
+    {
+        static void Delete(GLuint p)
+        {
+            if (p != 0)
+            {
+                glDeleteVertexArrays(1, &p);
+            }
+        }
+    };
+
+    struct OpenGLTextureDeleter
+    {
+        static void Delete(GLuint p)
+        {
+            if (p != 0)
+            {
+                glDeleteTextures(1, &p);
+            }
+        }
+    };
+
     using OpenGLShaderProgram = OpenGLObject<GLuint, OpenGLProgramDeleter>;
     using OpenGLVBO = OpenGLObject<GLuint, OpenGLVBODeleter>;
+    using OpenGLVAO = OpenGLObject<GLuint, OpenGLVAODeleter>;
+    using OpenGLTexture = OpenGLObject<GLuint, OpenGLTextureDeleter>;
+
+    // The generations of the parameters shared by all programs, as last
+    // uploaded to a program; zero means never
+    struct ProgramParameterGenerations
+    {
+        uint64_t OrthoMatrix;
+        uint64_t AmbientLightIntensity;
+
+        ProgramParameterGenerations()
+            : OrthoMatrix(0u)
+            , AmbientLightIntensity(0u)
+        {}
+    };
+
+    // A VAO sourcing from the ship point streams, together with the stream
+    // offsets its attributes currently point to
+    struct ShipPointsVAO
+    {
+        OpenGLVAO VAO;
+        size_t PositionOffset;
+        size_t ColourOffset;
+        size_t WaterOffset;
+        size_t LightOffset;
+
+        ShipPointsVAO()
+            : VAO(0u)
+            , PositionOffset(std::numeric_limits<size_t>::max())
+            , ColourOffset(std::numeric_limits<size_t>::max())
+            , WaterOffset(std::numeric_limits<size_t>::max())
+            , LightOffset(std::numeric_limits<size_t>::max())
+        {}
+    };
 
 private:
     
@@ -373,7 +867,104 @@ private:
         OpenGLShaderProgram const & shaderProgram,
         std::string const & parameterName);
 
-    void DescribeShipPointsVBO();
+    void CommitShipPointPositions(size_t points);
+
+    void CommitShipPointColours(size_t points);
+
+    void BeginShipTopology(
+        uint64_t version,
+        size_t points);
+
+    void UploadShipTopologyIndices(
+        int const * springIndices,
+        size_t springs,
+        int const * triangleIndices,
+        size_t triangles);
+
+    void SpecifyStressedSpringVBO(
+        int const * springIndices,
+        size_t springs,
+        size_t capacity);
+
+    void UploadShipIndices(
+        int const * indices,
+        size_t primitiveCount,
+        size_t indicesPerPrimitive,
+        GLuint elementVBO,
+        BufferType bufferType,
+        GLenum & indexType,
+        std::vector<ShipIndexChunk> & chunks);
+
+    void SetCommonParameters(
+        ProgramParameterGenerations & programParameterGenerations,
+        GLint ambientLightIntensityParameter,
+        GLint orthoMatrixParameter);
+
+    void DescribeShipPointsVBO(size_t basePoint);
+
+    void CreateShipPointsVAO(
+        ShipPointsVAO & shipPointsVAO,
+        GLuint elementVBO);
+
+    void BindShipPointsVAO(
+        ShipPointsVAO & shipPointsVAO,
+        size_t basePoint);
+
+    inline void BeginTimedPass(RenderPass pass)
+    {
+        mGpuPassTimer->BeginPass(static_cast<size_t>(pass));
+
+        mCurrentTimedPass = pass;
+    }
+
+    inline void EndTimedPass()
+    {
+        mGpuPassTimer->EndPass();
+
+        auto const now = std::chrono::steady_clock::now();
+        mCpuPassTimes[static_cast<size_t>(mCurrentTimedPass)] += std::chrono::duration<float, std::milli>(now - mCpuPassStartTime).count();
+        mCpuPassStartTime = now;
+    }
+
+    inline void CountUpload(
+        BufferType bufferType,
+        size_t bytes)
+    {
+        mFrameCounters.BytesUploaded[static_cast<size_t>(bufferType)] += bytes;
+    }
+
+    void UpdateBufferMemory(
+        BufferType bufferType,
+        size_t stagingBytes,
+        uint64_t newStagingAllocations,
+        size_t gpuBytes,
+        uint64_t newGpuAllocations);
+
+    inline void TrackStagingAllocation(
+        BufferType bufferType,
+        size_t bytes)
+    {
+        UpdateBufferMemory(bufferType, bytes, 1u, GetBufferMemory(bufferType).GpuBytes, 0u);
+    }
+
+    inline void TrackStagingRelease(BufferType bufferType)
+    {
+        UpdateBufferMemory(bufferType, 0u, 0u, GetBufferMemory(bufferType).GpuBytes, 0u);
+    }
+
+    // To be invoked at each glBufferData, which always allocates a new store
+    inline void TrackGpuAllocation(
+        BufferType bufferType,
+        size_t bytes)
+    {
+        UpdateBufferMemory(bufferType, GetBufferMemory(bufferType).StagingBytes, 0u, bytes, 1u);
+    }
+
+    void TrackStreamMemory(
+        BufferType bufferType,
+        StreamingBuffer const & stream);
+
+    void RenderPerformanceOverlay();
 
     void CalculateOrthoMatrix();
 
@@ -389,6 +980,7 @@ private:
     GLint mLandShaderLandColorParameter;
     GLint mLandShaderAmbientLightIntensityParameter;
     GLint mLandShaderOrthoMatrixParameter;
+    ProgramParameterGenerations mLandShaderParameterGenerations;
 
 #pragma pack(push)
     struct LandElement
@@ -400,11 +992,16 @@ private:
     };
 #pragma pack(pop)
 
+    // Only populated while an upload is in progress
     std::unique_ptr<LandElement[]> mLandBuffer;
     size_t mLandBufferSize;
     size_t mLandBufferMaxSize;
 
     OpenGLVBO mLandVBO;
+    OpenGLVAO mLandVAO;
+
+    // Version of the land currently in the VBO; zero when none
+    uint64_t mLandVersion;
 
 
     //
@@ -415,6 +1012,7 @@ private:
     GLint mWaterShaderWaterColorParameter;
     GLint mWaterShaderAmbientLightIntensityParameter;
     GLint mWaterShaderOrthoMatrixParameter;
+    ProgramParameterGenerations mWaterShaderParameterGenerations;
 
 #pragma pack(push)
     struct WaterElement
@@ -431,6 +1029,43 @@ private:
     size_t mWaterBufferMaxSize;
 
     OpenGLVBO mWaterVBO;
+    OpenGLVAO mWaterVAO;
+
+
+    //
+    // Water surface
+    //
+
+    OpenGLShaderProgram mWaterSurfaceShaderProgram;
+    GLint mWaterSurfaceShaderWaterColorParameter;
+    GLint mWaterSurfaceShaderAmbientLightIntensityParameter;
+    GLint mWaterSurfaceShaderOrthoMatrixParameter;
+    ProgramParameterGenerations mWaterSurfaceShaderParameterGenerations;
+    GLint mWaterSurfaceShaderTimeParameter;
+    GLint mWaterSurfaceShaderWaveHeightParameter;
+
+#pragma pack(push)
+    struct WaterSurfaceElement
+    {
+        float x1;
+        float y1;
+        float displacement1;
+        float x2;
+        float y2;
+        float displacement2;
+    };
+#pragma pack(pop)
+
+    // Only populated while an upload is in progress
+    std::unique_ptr<WaterSurfaceElement[]> mWaterSurfaceBuffer;
+    size_t mWaterSurfaceBufferSize;
+    size_t mWaterSurfaceBufferMaxSize;
+
+    OpenGLVBO mWaterSurfaceVBO;
+    OpenGLVAO mWaterSurfaceVAO;
+
+    // Version of the water grid currently in the VBO; zero when none
+    uint64_t mWaterSurfaceVersion;
 
 
     //
@@ -438,24 +1073,53 @@ private:
     //
 
     OpenGLShaderProgram mShipPointShaderProgram;
+    GLint mShipPointShaderAmbientLightIntensityParameter;
     GLint mShipPointShaderOrthoMatrixParameter;
+    ProgramParameterGenerations mShipPointShaderParameterGenerations;
 
 #pragma pack(push)
-    struct ShipPointElement
+    struct ShipPointPositionElement
     {
         float x;
         float y;
+    };
+#pragma pack(pop)
+
+    // The raw inputs of the point colour, the shading happening in the shaders; a
+    // colour segment is a plane of these, followed by a plane of waters and one of lights
+#pragma pack(push)
+    struct ShipPointColourElement
+    {
         float r;
         float g;
         float b;
     };
 #pragma pack(pop)
 
-    std::unique_ptr<ShipPointElement[]> mShipPointBuffer;
-    size_t mShipPointBufferSize;
-    size_t mShipPointBufferMaxSize;
+    static constexpr size_t ShipPointColourBytes = sizeof(ShipPointColourElement) + 2 * sizeof(float);
+
+    // Point straight into the streams' memory while an upload is in progress
+    ShipPointPositionElement * mShipPointPositionBuffer;
+    size_t mShipPointPositionBufferSize;
+    size_t mShipPointPositionBufferMaxSize;
+
+    ShipPointColourElement * mShipPointColourBuffer;
+    float * mShipPointWaterBuffer;
+    float * mShipPointLightBuffer;
+    size_t mShipPointColourBufferSize;
+    size_t mShipPointColourBufferMaxSize;
+
+    std::unique_ptr<StreamingBuffer> mShipPointPositionStream;
+    std::unique_ptr<StreamingBuffer> mShipPointColourStream;
+
+    bool mAreShipPointPositionsDirty;
+    bool mAreShipPointColoursDirty;
 
-    OpenGLVBO mShipPointVBO;
+    // The number of points currently in the streams
+    size_t mShipPointPositionCount;
+    size_t mShipPointColourCount;
+
+    ShipPointsVAO mShipPointVAO;
 
 
     //
@@ -463,7 +1127,9 @@ private:
     //
 
     OpenGLShaderProgram mSpringShaderProgram;
+    GLint mSpringShaderAmbientLightIntensityParameter;
     GLint mSpringShaderOrthoMatrixParameter;
+    ProgramParameterGenerations mSpringShaderParameterGenerations;
 
 #pragma pack(push)
     struct SpringElement
@@ -473,11 +1139,13 @@ private:
     };
 #pragma pack(pop)
 
+    // Only populated while a topology upload is in progress
     std::unique_ptr<SpringElement[]> mSpringBuffer;
     size_t mSpringBufferSize;
     size_t mSpringBufferMaxSize;
 
     OpenGLVBO mSpringVBO;
+    ShipPointsVAO mSpringVAO;
 
 
     //
@@ -487,12 +1155,21 @@ private:
     OpenGLShaderProgram mStressedSpringShaderProgram;
     GLint mStressedSpringShaderAmbientLightIntensityParameter;
     GLint mStressedSpringShaderOrthoMatrixParameter;
+    ProgramParameterGenerations mStressedSpringShaderParameterGenerations;
 
     std::unique_ptr<SpringElement[]> mStressedSpringBuffer;
     size_t mStressedSpringBufferSize;
     size_t mStressedSpringBufferMaxSize;
 
     OpenGLVBO mStressedSpringVBO;
+    ShipPointsVAO mStressedSpringVAO;
+
+    // The springs in the VBO, and how many it may hold before it needs a new store
+    size_t mStressedSpringCount;
+    size_t mStressedSpringVBOCapacity;
+
+    // Version of the caller's set currently in the VBO; zero when none
+    uint64_t mStressedSpringsVersion;
 
 
     //
@@ -500,7 +1177,9 @@ private:
     //
 
     OpenGLShaderProgram mShipTriangleShaderProgram;
+    GLint mShipTriangleShaderAmbientLightIntensityParameter;
     GLint mShipTriangleShaderOrthoMatrixParameter;
+    ProgramParameterGenerations mShipTriangleShaderParameterGenerations;
 
 #pragma pack(push)
     struct ShipTriangleElement
@@ -511,11 +1190,106 @@ private:
     };
 #pragma pack(pop)
 
+    // Only populated while a topology upload is in progress
     std::unique_ptr<ShipTriangleElement[]> mShipTriangleBuffer;
     size_t mShipTriangleBufferSize;
     size_t mShipTriangleBufferMaxSize;
 
     OpenGLVBO mShipTriangleVBO;
+    ShipPointsVAO mShipTriangleVAO;
+
+    // Version of the topology currently in the spring and triangle VBOs; zero when none
+    uint64_t mShipTopologyVersion;
+
+    // The type of the indices in the spring and triangle VBOs, and how they're split
+    GLenum mSpringIndexType;
+    std::vector<ShipIndexChunk> mSpringChunks;
+    GLenum mShipTriangleIndexType;
+    std::vector<ShipIndexChunk> mShipTriangleChunks;
+
+    bool mUseShipIndexChunks;
+
+private:
+
+    //
+    // Vertex array objects
+    //
+    // With VAOs (ARB_vertex_array_object, or any GL 3.0+ compatibility context)
+    // each pass's vertex layout is captured once; without them, each pass
+    // re-describes its attributes every time it's drawn.
+    //
+
+    bool const mUseVertexArrayObjects;
+
+    size_t mAttributeSetupCallsSaved;
+
+
+    //
+    // State
+    //
+    // All the state that differs between passes goes through here, and each
+    // pass sets all of the state it depends on.
+    //
+
+    OpenGLStateTracker mGLState;
+
+
+    //
+    // GPU timing
+    //
+    // Each pass's draws are wrapped in a timer query, read back a few frames later.
+    //
+
+    std::unique_ptr<GpuPassTimer> mGpuPassTimer;
+
+
+    //
+    // CPU timing
+    //
+    // Each pass's time is this frame's time since the previous pass ended; the
+    // averages are exponential, over roughly the last 32 frames.
+    //
+
+    std::chrono::steady_clock::time_point mCpuPassStartTime;
+    RenderPass mCurrentTimedPass;
+    float mCpuPassTimes[static_cast<size_t>(RenderPass::_Count)];
+    float mAverageCpuPassTimes[static_cast<size_t>(RenderPass::_Count)];
+
+    // The time between the starts of consecutive frames
+    std::chrono::steady_clock::time_point mLastRenderStartTime;
+    float mAverageFrameTime;
+
+
+    //
+    // Frame counters
+    //
+
+    FrameCounters mFrameCounters;
+    FrameCounters mLastFrameCounters;
+
+
+    //
+    // Memory accounting
+    //
+
+    BufferMemory mBufferMemory[static_cast<size_t>(BufferType::_Count)];
+    BufferMemory mTotalBufferMemory;
+
+
+    //
+    // Performance overlay
+    //
+
+    bool mShowPerformanceOverlay;
+    PerformanceOverlay mPerformanceOverlay;
+
+    OpenGLShaderProgram mOverlayShaderProgram;
+    GLint mOverlayShaderCanvasSizeParameter;
+    ProgramParameterGenerations mOverlayShaderParameterGenerations;
+
+    OpenGLVBO mOverlayVBO;
+    OpenGLVAO mOverlayVAO;
+    OpenGLTexture mOverlayFontTexture;
 
 private:
 
@@ -538,6 +1312,10 @@ private:
     int mCanvasHeight;
     float mAmbientLightIntensity;
 
+    // Bumped whenever the ortho matrix or the lighting change
+    uint64_t mOrthoMatrixGeneration;
+    uint64_t mAmbientLightIntensityGeneration;
+
     bool mShowStress;
     bool mUseXRayMode;
     bool mShowShipThroughWater;
@@ -0,0 +1,243 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "RenderRecorder.h"
+
+#include "GameException.h"
+
+constexpr char RenderRecorder::FileMagic[4];
+
+RenderRecorder::RenderRecorder(
+    RenderContext & renderContext,
+    std::string const & filePath)
+    : mRenderContext(renderContext)
+    , mFilePath(filePath)
+    , mFile(nullptr)
+    , mFrameBuffer()
+    , mBlockCountOffset(NoBlock)
+    , mBlockElementCount(0u)
+    , mTriangleIndices()
+    , mIsViewRecorded(false)
+    , mCanvasWidth(0)
+    , mCanvasHeight(0)
+    , mZoom(0.0f)
+    , mCameraWorldPosition(0.0f, 0.0f)
+    , mAmbientLightIntensity(0.0f)
+    , mRecordedFrameCount(0u)
+    , mRecordedBytes(0u)
+{
+    mFile = fopen(filePath.c_str(), "wb");
+    if (nullptr == mFile)
+    {
+        throw GameException("Cannot open render recording file \"" + filePath + "\" for writing");
+    }
+
+    mFrameBuffer.reserve(1024 * 1024);
+
+    Write(FileMagic);
+    Write(FileVersion);
+    Flush();
+
+    mRenderContext.InvalidateLand();
+    mRenderContext.InvalidateWaterSurface();
+    mRenderContext.InvalidateShipPointPositions();
+    mRenderContext.InvalidateShipPointColours();
+    mRenderContext.InvalidateShipTopology();
+    mRenderContext.InvalidateStressedSprings();
+}
+
+RenderRecorder::~RenderRecorder()
+{
+    if (nullptr != mFile)
+    {
+        fclose(mFile);
+    }
+}
+
+void RenderRecorder::RenderStart()
+{
+    //
+    // Record the view parameters that changed since the last frame
+    //
+
+    int const canvasWidth = mRenderContext.GetCanvasSizeWidth();
+    int const canvasHeight = mRenderContext.GetCanvasSizeHeight();
+    if (!mIsViewRecorded || canvasWidth != mCanvasWidth || canvasHeight != mCanvasHeight)
+    {
+        Write(Command::SetCanvasSize);
+        Write(canvasWidth);
+        Write(canvasHeight);
+
+        mCanvasWidth = canvasWidth;
+        mCanvasHeight = canvasHeight;
+    }
+
+    float const zoom = mRenderContext.GetZoom();
+    if (!mIsViewRecorded || zoom != mZoom)
+    {
+        Write(Command::SetZoom);
+        Write(zoom);
+
+        mZoom = zoom;
+    }
+
+    vec2f const cameraWorldPosition = mRenderContext.GetCameraWorldPosition();
+    if (!mIsViewRecorded || cameraWorldPosition.x != mCameraWorldPosition.x || cameraWorldPosition.y != mCameraWorldPosition.y)
+    {
+        Write(Command::SetCameraWorldPosition);
+        Write(cameraWorldPosition.x);
+        Write(cameraWorldPosition.y);
+
+        mCameraWorldPosition = cameraWorldPosition;
+    }
+
+    float const ambientLightIntensity = mRenderContext.GetAmbientLightIntensity();
+    if (!mIsViewRecorded || ambientLightIntensity != mAmbientLightIntensity)
+    {
+        Write(Command::SetAmbientLightIntensity);
+        Write(ambientLightIntensity);
+
+        mAmbientLightIntensity = ambientLightIntensity;
+    }
+
+    mIsViewRecorded = true;
+
+    mRenderContext.RenderStart();
+
+    Write(Command::RenderStart);
+}
+
+void RenderRecorder::UploadShipPointPositions(
+    vec2f const * positions,
+    size_t points)
+{
+    mRenderContext.UploadShipPointPositions(positions, points);
+
+    BeginBlock(Command::UploadShipPointPositions);
+    WriteElements(positions, sizeof(vec2f), points);
+    EndBlock();
+}
+
+void RenderRecorder::UploadShipPointColours(
+    vec3f const * colours,
+    float const * waters,
+    float const * lights,
+    size_t points)
+{
+    mRenderContext.UploadShipPointColours(colours, waters, lights, points);
+
+    // Recorded interleaved, as the single colour uploads are
+    BeginBlock(Command::UploadShipPointColours);
+    for (size_t i = 0; i < points; ++i)
+    {
+        WriteElement(colours[i].x, colours[i].y, colours[i].z, waters[i], lights[i]);
+    }
+    EndBlock();
+}
+
+void RenderRecorder::UploadShipTopologyStart(
+    uint64_t version,
+    size_t points,
+    size_t springs,
+    size_t triangles)
+{
+    mRenderContext.UploadShipTopologyStart(version, points, springs, triangles);
+
+    BeginBlock(Command::UploadShipTopology);
+    Write(version);
+    Write(static_cast<uint64_t>(points));
+
+    mTriangleIndices.clear();
+    mTriangleIndices.reserve(triangles * 3);
+}
+
+void RenderRecorder::UploadShipTopologyEnd()
+{
+    mRenderContext.UploadShipTopologyEnd();
+
+    EndBlock();
+
+    Write(static_cast<uint64_t>(mTriangleIndices.size() / 3));
+    for (int index : mTriangleIndices)
+    {
+        Write(index);
+    }
+}
+
+void RenderRecorder::UploadShipTopology(
+    uint64_t version,
+    size_t points,
+    int const * springIndices,
+    size_t springs,
+    int const * triangleIndices,
+    size_t triangles)
+{
+    mRenderContext.UploadShipTopology(version, points, springIndices, springs, triangleIndices, triangles);
+
+    BeginBlock(Command::UploadShipTopology);
+    Write(version);
+    Write(static_cast<uint64_t>(points));
+    WriteElements(springIndices, 2 * sizeof(int), springs);
+    EndBlock();
+
+    Write(static_cast<uint64_t>(triangles));
+    for (size_t i = 0; i < triangles * 3; ++i)
+    {
+        Write(triangleIndices[i]);
+    }
+}
+
+void RenderRecorder::UploadStressedSprings(
+    uint64_t version,
+    int const * springIndices,
+    size_t springs)
+{
+    mRenderContext.UploadStressedSprings(version, springIndices, springs);
+
+    BeginBlock(Command::UploadStressedSprings);
+    Write(version);
+    WriteElements(springIndices, 2 * sizeof(int), springs);
+    EndBlock();
+}
+
+void RenderRecorder::UpdateStressedSprings(
+    int const * springIndices,
+    size_t springs,
+    size_t dirtyStart,
+    size_t dirtyEnd)
+{
+    mRenderContext.UpdateStressedSprings(springIndices, springs, dirtyStart, dirtyEnd);
+
+    BeginBlock(Command::UpdateStressedSprings);
+    Write(static_cast<uint64_t>(springs));
+    Write(static_cast<uint64_t>(dirtyStart));
+    WriteElements(springIndices + 2 * dirtyStart, 2 * sizeof(int), dirtyEnd - dirtyStart);
+    EndBlock();
+}
+
+RenderContext::FrameCounters const & RenderRecorder::RenderEnd()
+{
+    RenderContext::FrameCounters const & frameCounters = mRenderContext.RenderEnd();
+
+    Write(Command::RenderEnd);
+    Flush();
+
+    ++mRecordedFrameCount;
+
+    return frameCounters;
+}
+
+void RenderRecorder::Flush()
+{
+    assert(mBlockCountOffset == NoBlock);
+
+    if (mFrameBuffer.size() != fwrite(mFrameBuffer.data(), 1, mFrameBuffer.size(), mFile))
+    {
+        throw GameException("Error writing render recording file \"" + mFilePath + "\"");
+    }
+
+    mRecordedBytes += mFrameBuffer.size();
+    mFrameBuffer.clear();
+}
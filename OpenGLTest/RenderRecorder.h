@@ -0,0 +1,517 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "RenderContext.h"
+#include "Vectors.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/*
+ * Stands in for RenderContext in World::Render, forwarding every call to the
+ * wrapped RenderContext and serializing it, with its arguments, to a binary file
+ * that RenderReplayer plays back.
+ *
+ * The view parameters - canvas size, zoom, camera position and ambient light -
+ * are set on the RenderContext directly by whoever drives it, and are thus
+ * sampled at each RenderStart and recorded only when they change.
+ *
+ * The file is a header followed by a stream of commands, each a one-byte opcode
+ * followed by its arguments, in native byte order. The elements of each upload
+ * are buffered between the *Start and *End calls and written as a single block
+ * with its element count, so elements carry no per-element opcode. Bulk uploads
+ * are recorded as the equivalent Start/End call sequence, hence replay the same.
+ */
+class RenderRecorder
+{
+public:
+
+    static constexpr char FileMagic[4] = { 'O', 'G', 'T', 'R' };
+    // Version 2 only added commands, hence version 1 files still replay
+    static constexpr uint32_t FileVersion = 2u;
+
+    enum class Command : uint8_t
+    {
+        SetCanvasSize = 1,
+        SetZoom,
+        SetCameraWorldPosition,
+        SetAmbientLightIntensity,
+        RenderStart,
+        UploadLand,
+        RenderLand,
+        RenderWater,
+        UploadWaterSurface,
+        RenderWaterSurface,
+        UploadShipPointPositions,
+        UploadShipPointColours,
+        RenderShipPoints,
+        UploadShipTopology,
+        RenderSprings,
+        RenderStressedSprings,
+        RenderShipTriangles,
+        RenderEnd,
+        UploadStressedSprings,
+        UpdateStressedSprings,
+        RenderUploadedStressedSprings
+    };
+
+public:
+
+    /*
+     * Starts recording into the specified file, which is overwritten.
+     *
+     * All of the render context's buffers are invalidated, so that the first
+     * recorded frame uploads everything it draws.
+     */
+    RenderRecorder(
+        RenderContext & renderContext,
+        std::string const & filePath);
+
+    ~RenderRecorder();
+
+    RenderRecorder(RenderRecorder const & other) = delete;
+    RenderRecorder & operator=(RenderRecorder const & other) = delete;
+
+    size_t GetRecordedFrameCount() const
+    {
+        return mRecordedFrameCount;
+    }
+
+    uint64_t GetRecordedBytes() const
+    {
+        return mRecordedBytes;
+    }
+
+public:
+
+    void RenderStart();
+
+
+    //
+    // Land
+    //
+
+    uint64_t GetLandVersion() const
+    {
+        return mRenderContext.GetLandVersion();
+    }
+
+    void UploadLandStart(
+        uint64_t version,
+        size_t slices)
+    {
+        mRenderContext.UploadLandStart(version, slices);
+
+        BeginBlock(Command::UploadLand);
+        Write(version);
+    }
+
+    inline void UploadLand(
+        float x,
+        float bottom,
+        float top)
+    {
+        mRenderContext.UploadLand(x, bottom, top);
+
+        WriteElement(x, bottom, top);
+    }
+
+    void UploadLandEnd()
+    {
+        mRenderContext.UploadLandEnd();
+
+        EndBlock();
+    }
+
+    void RenderLand()
+    {
+        mRenderContext.RenderLand();
+
+        Write(Command::RenderLand);
+    }
+
+
+    //
+    // Water
+    //
+
+    void RenderWaterStart(size_t slices)
+    {
+        mRenderContext.RenderWaterStart(slices);
+
+        BeginBlock(Command::RenderWater);
+    }
+
+    inline void RenderWater(
+        float x,
+        float bottom,
+        float top)
+    {
+        mRenderContext.RenderWater(x, bottom, top);
+
+        WriteElement(x, bottom, top);
+    }
+
+    void RenderWaterEnd()
+    {
+        mRenderContext.RenderWaterEnd();
+
+        EndBlock();
+    }
+
+
+    //
+    // Water surface
+    //
+
+    uint64_t GetWaterSurfaceVersion() const
+    {
+        return mRenderContext.GetWaterSurfaceVersion();
+    }
+
+    void UploadWaterSurfaceStart(
+        uint64_t version,
+        size_t slices)
+    {
+        mRenderContext.UploadWaterSurfaceStart(version, slices);
+
+        BeginBlock(Command::UploadWaterSurface);
+        Write(version);
+    }
+
+    inline void UploadWaterSurface(
+        float x,
+        float bottom)
+    {
+        mRenderContext.UploadWaterSurface(x, bottom);
+
+        WriteElement(x, bottom);
+    }
+
+    void UploadWaterSurfaceEnd()
+    {
+        mRenderContext.UploadWaterSurfaceEnd();
+
+        EndBlock();
+    }
+
+    void RenderWaterSurface(
+        float time,
+        float waveHeight)
+    {
+        mRenderContext.RenderWaterSurface(time, waveHeight);
+
+        Write(Command::RenderWaterSurface);
+        Write(time);
+        Write(waveHeight);
+    }
+
+
+    //
+    // Ship Points
+    //
+
+    bool AreShipPointPositionsDirty() const
+    {
+        return mRenderContext.AreShipPointPositionsDirty();
+    }
+
+    void InvalidateShipPointPositions()
+    {
+        mRenderContext.InvalidateShipPointPositions();
+    }
+
+    void UploadShipPointPositionsStart(size_t points)
+    {
+        mRenderContext.UploadShipPointPositionsStart(points);
+
+        BeginBlock(Command::UploadShipPointPositions);
+    }
+
+    inline void UploadShipPointPosition(
+        float x,
+        float y)
+    {
+        mRenderContext.UploadShipPointPosition(x, y);
+
+        WriteElement(x, y);
+    }
+
+    void UploadShipPointPositionsEnd()
+    {
+        mRenderContext.UploadShipPointPositionsEnd();
+
+        EndBlock();
+    }
+
+    void UploadShipPointPositions(
+        vec2f const * positions,
+        size_t points);
+
+    bool AreShipPointColoursDirty() const
+    {
+        return mRenderContext.AreShipPointColoursDirty();
+    }
+
+    void InvalidateShipPointColours()
+    {
+        mRenderContext.InvalidateShipPointColours();
+    }
+
+    void UploadShipPointColoursStart(size_t points)
+    {
+        mRenderContext.UploadShipPointColoursStart(points);
+
+        BeginBlock(Command::UploadShipPointColours);
+    }
+
+    inline void UploadShipPointColour(
+        float r,
+        float g,
+        float b,
+        float water,
+        float light)
+    {
+        mRenderContext.UploadShipPointColour(r, g, b, water, light);
+
+        WriteElement(r, g, b, water, light);
+    }
+
+    void UploadShipPointColoursEnd()
+    {
+        mRenderContext.UploadShipPointColoursEnd();
+
+        EndBlock();
+    }
+
+    void UploadShipPointColours(
+        vec3f const * colours,
+        float const * waters,
+        float const * lights,
+        size_t points);
+
+    void RenderShipPoints()
+    {
+        mRenderContext.RenderShipPoints();
+
+        Write(Command::RenderShipPoints);
+    }
+
+
+    //
+    // Ship topology
+    //
+    // Written as the point count, followed by the springs block and by the
+    // triangles block; the triangles are buffered separately as the calls
+    // for the two may in principle interleave.
+    //
+
+    uint64_t GetShipTopologyVersion() const
+    {
+        return mRenderContext.GetShipTopologyVersion();
+    }
+
+    void UploadShipTopologyStart(
+        uint64_t version,
+        size_t points,
+        size_t springs,
+        size_t triangles);
+
+    inline void UploadShipSpring(
+        int shipPointIndex1,
+        int shipPointIndex2)
+    {
+        mRenderContext.UploadShipSpring(shipPointIndex1, shipPointIndex2);
+
+        WriteElement(shipPointIndex1, shipPointIndex2);
+    }
+
+    inline void UploadShipTriangle(
+        int shipPointIndex1,
+        int shipPointIndex2,
+        int shipPointIndex3)
+    {
+        mRenderContext.UploadShipTriangle(shipPointIndex1, shipPointIndex2, shipPointIndex3);
+
+        mTriangleIndices.push_back(shipPointIndex1);
+        mTriangleIndices.push_back(shipPointIndex2);
+        mTriangleIndices.push_back(shipPointIndex3);
+    }
+
+    void UploadShipTopologyEnd();
+
+    void UploadShipTopology(
+        uint64_t version,
+        size_t points,
+        int const * springIndices,
+        size_t springs,
+        int const * triangleIndices,
+        size_t triangles);
+
+
+    //
+    // Springs
+    //
+
+    void RenderSprings()
+    {
+        mRenderContext.RenderSprings();
+
+        Write(Command::RenderSprings);
+    }
+
+    //
+    // The incremental updates of the stressed spring set only record the new size
+    // of the set and its dirty range, which a replay applies to its own copy
+    //
+
+    uint64_t GetStressedSpringsVersion() const
+    {
+        return mRenderContext.GetStressedSpringsVersion();
+    }
+
+    void UploadStressedSprings(
+        uint64_t version,
+        int const * springIndices,
+        size_t springs);
+
+    void UpdateStressedSprings(
+        int const * springIndices,
+        size_t springs,
+        size_t dirtyStart,
+        size_t dirtyEnd);
+
+    void RenderStressedSprings()
+    {
+        mRenderContext.RenderStressedSprings();
+
+        Write(Command::RenderUploadedStressedSprings);
+    }
+
+    void RenderStressedSpringsStart(size_t maxSprings)
+    {
+        mRenderContext.RenderStressedSpringsStart(maxSprings);
+
+        BeginBlock(Command::RenderStressedSprings);
+        Write(static_cast<uint64_t>(maxSprings));
+    }
+
+    inline void RenderStressedSpring(
+        int shipPointIndex1,
+        int shipPointIndex2)
+    {
+        mRenderContext.RenderStressedSpring(shipPointIndex1, shipPointIndex2);
+
+        WriteElement(shipPointIndex1, shipPointIndex2);
+    }
+
+    void RenderStressedSpringsEnd()
+    {
+        mRenderContext.RenderStressedSpringsEnd();
+
+        EndBlock();
+    }
+
+
+    //
+    // Ship triangles
+    //
+
+    void RenderShipTriangles()
+    {
+        mRenderContext.RenderShipTriangles();
+
+        Write(Command::RenderShipTriangles);
+    }
+
+    RenderContext::FrameCounters const & RenderEnd();
+
+private:
+
+    template<typename T>
+    inline void Write(T const & value)
+    {
+        size_t const offset = mFrameBuffer.size();
+        mFrameBuffer.resize(offset + sizeof(T));
+        std::memcpy(mFrameBuffer.data() + offset, &value, sizeof(T));
+    }
+
+    template<typename... TFields>
+    inline void WriteElement(TFields... fields)
+    {
+        assert(mBlockCountOffset != NoBlock);
+
+        (Write(fields), ...);
+        ++mBlockElementCount;
+    }
+
+    // Appends elements laid out as a block's, fields back to back
+    inline void WriteElements(
+        void const * elements,
+        size_t elementSize,
+        size_t count)
+    {
+        assert(mBlockCountOffset != NoBlock);
+
+        size_t const offset = mFrameBuffer.size();
+        mFrameBuffer.resize(offset + count * elementSize);
+        std::memcpy(mFrameBuffer.data() + offset, elements, count * elementSize);
+        mBlockElementCount += count;
+    }
+
+    void BeginBlock(Command command)
+    {
+        assert(mBlockCountOffset == NoBlock);
+
+        Write(command);
+
+        // The element count is patched in by EndBlock
+        mBlockCountOffset = mFrameBuffer.size();
+        mBlockElementCount = 0u;
+        Write(mBlockElementCount);
+    }
+
+    void EndBlock()
+    {
+        assert(mBlockCountOffset != NoBlock);
+
+        std::memcpy(mFrameBuffer.data() + mBlockCountOffset, &mBlockElementCount, sizeof(mBlockElementCount));
+        mBlockCountOffset = NoBlock;
+    }
+
+    void Flush();
+
+private:
+
+    static constexpr size_t NoBlock = static_cast<size_t>(-1);
+
+    RenderContext & mRenderContext;
+    std::string const mFilePath;
+    FILE * mFile;
+
+    // The commands of the current frame, written to the file at each RenderEnd
+    std::vector<uint8_t> mFrameBuffer;
+    size_t mBlockCountOffset;
+    uint64_t mBlockElementCount;
+    std::vector<int> mTriangleIndices;
+
+    // The view parameters as last recorded
+    bool mIsViewRecorded;
+    int mCanvasWidth;
+    int mCanvasHeight;
+    float mZoom;
+    vec2f mCameraWorldPosition;
+    float mAmbientLightIntensity;
+
+    size_t mRecordedFrameCount;
+    uint64_t mRecordedBytes;
+};
@@ -0,0 +1,494 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "RenderReplayer.h"
+
+#include "GameException.h"
+#include "RenderRecorder.h"
+
+#include <cstdio>
+
+RenderReplayer::RenderReplayer(std::string const & filePath)
+    : mFilePath(filePath)
+    , mData()
+    , mFirstFrameOffset(0u)
+    , mReadOffset(0u)
+    , mFrameCount(0u)
+    , mIndices()
+    , mStressedSpringIndices()
+{
+    //
+    // Load the file
+    //
+
+    FILE * file = fopen(filePath.c_str(), "rb");
+    if (nullptr == file)
+    {
+        throw GameException("Cannot open render recording file \"" + filePath + "\"");
+    }
+
+    uint8_t chunk[64 * 1024];
+    size_t readBytes;
+    while ((readBytes = fread(chunk, 1, sizeof(chunk), file)) > 0)
+    {
+        mData.insert(mData.end(), chunk, chunk + readBytes);
+    }
+
+    bool const isError = !!ferror(file);
+    fclose(file);
+
+    if (isError)
+    {
+        throw GameException("Error reading render recording file \"" + filePath + "\"");
+    }
+
+    //
+    // Check the header
+    //
+
+    CheckAvailable(sizeof(RenderRecorder::FileMagic) + sizeof(RenderRecorder::FileVersion));
+
+    if (0 != std::memcmp(mData.data(), RenderRecorder::FileMagic, sizeof(RenderRecorder::FileMagic)))
+    {
+        throw GameException("File \"" + filePath + "\" is not a render recording");
+    }
+
+    mReadOffset = sizeof(RenderRecorder::FileMagic);
+
+    uint32_t const version = Read<uint32_t>();
+    if (version < 1u || version > RenderRecorder::FileVersion)
+    {
+        throw GameException("Render recording file \"" + filePath + "\" has unsupported version " + std::to_string(version));
+    }
+
+    mFirstFrameOffset = mReadOffset;
+
+    //
+    // Validate and count the frames
+    //
+
+    while (ProcessFrame(nullptr))
+    {
+        ++mFrameCount;
+    }
+
+    Rewind();
+}
+
+bool RenderReplayer::ReplayFrame(RenderContext & renderContext)
+{
+    return ProcessFrame(&renderContext);
+}
+
+void RenderReplayer::CheckAvailable(size_t size) const
+{
+    if (mData.size() - mReadOffset < size)
+    {
+        throw GameException("Render recording file \"" + mFilePath + "\" is truncated");
+    }
+}
+
+uint64_t RenderReplayer::ReadElementCount(size_t elementSize)
+{
+    uint64_t const count = Read<uint64_t>();
+
+    if (count > (mData.size() - mReadOffset) / elementSize)
+    {
+        throw GameException("Render recording file \"" + mFilePath + "\" is truncated");
+    }
+
+    return count;
+}
+
+int const * RenderReplayer::ReadIndices(size_t count)
+{
+    CheckAvailable(count * sizeof(int));
+
+    mIndices.resize(count);
+    std::memcpy(mIndices.data(), mData.data() + mReadOffset, count * sizeof(int));
+    mReadOffset += count * sizeof(int);
+
+    return mIndices.data();
+}
+
+bool RenderReplayer::ProcessFrame(RenderContext * renderContext)
+{
+    using Command = RenderRecorder::Command;
+
+    if (mReadOffset == mData.size())
+        return false;
+
+    while (true)
+    {
+        Command const command = Read<Command>();
+
+        switch (command)
+        {
+            case Command::SetCanvasSize:
+            {
+                int const width = Read<int>();
+                int const height = Read<int>();
+                if (nullptr != renderContext)
+                    renderContext->SetCanvasSize(width, height);
+                break;
+            }
+
+            case Command::SetZoom:
+            {
+                float const zoom = Read<float>();
+                if (nullptr != renderContext)
+                    renderContext->SetZoom(zoom);
+                break;
+            }
+
+            case Command::SetCameraWorldPosition:
+            {
+                float const x = Read<float>();
+                float const y = Read<float>();
+                if (nullptr != renderContext)
+                    renderContext->SetCameraWorldPosition(vec2f(x, y));
+                break;
+            }
+
+            case Command::SetAmbientLightIntensity:
+            {
+                float const intensity = Read<float>();
+                if (nullptr != renderContext)
+                    renderContext->SetAmbientLightIntensity(intensity);
+                break;
+            }
+
+            case Command::RenderStart:
+            {
+                if (nullptr != renderContext)
+                    renderContext->RenderStart();
+                break;
+            }
+
+            case Command::UploadLand:
+            {
+                uint64_t const count = Read<uint64_t>();
+                uint64_t const version = Read<uint64_t>();
+                if (count == 0 || count > (mData.size() - mReadOffset) / (3 * sizeof(float)))
+                    throw GameException("Render recording file \"" + mFilePath + "\" has an invalid land upload");
+
+                if (nullptr != renderContext)
+                {
+                    renderContext->UploadLandStart(version, static_cast<size_t>(count - 1));
+                    for (uint64_t i = 0; i < count; ++i)
+                    {
+                        float const x = Read<float>();
+                        float const bottom = Read<float>();
+                        float const top = Read<float>();
+                        renderContext->UploadLand(x, bottom, top);
+                    }
+
+                    renderContext->UploadLandEnd();
+                }
+                else
+                {
+                    mReadOffset += count * 3 * sizeof(float);
+                }
+
+                break;
+            }
+
+            case Command::RenderLand:
+            {
+                if (nullptr != renderContext)
+                    renderContext->RenderLand();
+                break;
+            }
+
+            case Command::RenderWater:
+            {
+                uint64_t const count = ReadElementCount(3 * sizeof(float));
+                if (count == 0)
+                    throw GameException("Render recording file \"" + mFilePath + "\" has an invalid water render");
+
+                if (nullptr != renderContext)
+                {
+                    renderContext->RenderWaterStart(static_cast<size_t>(count - 1));
+                    for (uint64_t i = 0; i < count; ++i)
+                    {
+                        float const x = Read<float>();
+                        float const bottom = Read<float>();
+                        float const top = Read<float>();
+                        renderContext->RenderWater(x, bottom, top);
+                    }
+
+                    renderContext->RenderWaterEnd();
+                }
+                else
+                {
+                    mReadOffset += count * 3 * sizeof(float);
+                }
+
+                break;
+            }
+
+            case Command::UploadWaterSurface:
+            {
+                uint64_t const count = Read<uint64_t>();
+                uint64_t const version = Read<uint64_t>();
+                if (count == 0 || count > (mData.size() - mReadOffset) / (2 * sizeof(float)))
+                    throw GameException("Render recording file \"" + mFilePath + "\" has an invalid water surface upload");
+
+                if (nullptr != renderContext)
+                {
+                    renderContext->UploadWaterSurfaceStart(version, static_cast<size_t>(count - 1));
+                    for (uint64_t i = 0; i < count; ++i)
+                    {
+                        float const x = Read<float>();
+                        float const bottom = Read<float>();
+                        renderContext->UploadWaterSurface(x, bottom);
+                    }
+
+                    renderContext->UploadWaterSurfaceEnd();
+                }
+                else
+                {
+                    mReadOffset += count * 2 * sizeof(float);
+                }
+
+                break;
+            }
+
+            case Command::RenderWaterSurface:
+            {
+                float const time = Read<float>();
+                float const waveHeight = Read<float>();
+                if (nullptr != renderContext)
+                    renderContext->RenderWaterSurface(time, waveHeight);
+                break;
+            }
+
+            case Command::UploadShipPointPositions:
+            {
+                uint64_t const count = ReadElementCount(2 * sizeof(float));
+
+                if (nullptr != renderContext)
+                {
+                    renderContext->UploadShipPointPositionsStart(static_cast<size_t>(count));
+                    for (uint64_t i = 0; i < count; ++i)
+                    {
+                        float const x = Read<float>();
+                        float const y = Read<float>();
+                        renderContext->UploadShipPointPosition(x, y);
+                    }
+
+                    renderContext->UploadShipPointPositionsEnd();
+                }
+                else
+                {
+                    mReadOffset += count * 2 * sizeof(float);
+                }
+
+                break;
+            }
+
+            case Command::UploadShipPointColours:
+            {
+                uint64_t const count = ReadElementCount(5 * sizeof(float));
+
+                if (nullptr != renderContext)
+                {
+                    renderContext->UploadShipPointColoursStart(static_cast<size_t>(count));
+                    for (uint64_t i = 0; i < count; ++i)
+                    {
+                        float const r = Read<float>();
+                        float const g = Read<float>();
+                        float const b = Read<float>();
+                        float const water = Read<float>();
+                        float const light = Read<float>();
+                        renderContext->UploadShipPointColour(r, g, b, water, light);
+                    }
+
+                    renderContext->UploadShipPointColoursEnd();
+                }
+                else
+                {
+                    mReadOffset += count * 5 * sizeof(float);
+                }
+
+                break;
+            }
+
+            case Command::RenderShipPoints:
+            {
+                if (nullptr != renderContext)
+                    renderContext->RenderShipPoints();
+                break;
+            }
+
+            case Command::UploadShipTopology:
+            {
+                uint64_t const springCount = Read<uint64_t>();
+                uint64_t const version = Read<uint64_t>();
+                uint64_t const pointCount = Read<uint64_t>();
+                if (springCount > (mData.size() - mReadOffset) / (2 * sizeof(int)))
+                    throw GameException("Render recording file \"" + mFilePath + "\" is truncated");
+
+                size_t const springsOffset = mReadOffset;
+                mReadOffset += springCount * 2 * sizeof(int);
+
+                uint64_t const triangleCount = ReadElementCount(3 * sizeof(int));
+
+                if (nullptr != renderContext)
+                {
+                    size_t const trianglesOffset = mReadOffset;
+
+                    renderContext->UploadShipTopologyStart(
+                        version,
+                        static_cast<size_t>(pointCount),
+                        static_cast<size_t>(springCount),
+                        static_cast<size_t>(triangleCount));
+
+                    mReadOffset = springsOffset;
+                    for (uint64_t i = 0; i < springCount; ++i)
+                    {
+                        int const pointIndex1 = Read<int>();
+                        int const pointIndex2 = Read<int>();
+                        renderContext->UploadShipSpring(pointIndex1, pointIndex2);
+                    }
+
+                    mReadOffset = trianglesOffset;
+                    for (uint64_t i = 0; i < triangleCount; ++i)
+                    {
+                        int const pointIndex1 = Read<int>();
+                        int const pointIndex2 = Read<int>();
+                        int const pointIndex3 = Read<int>();
+                        renderContext->UploadShipTriangle(pointIndex1, pointIndex2, pointIndex3);
+                    }
+
+                    renderContext->UploadShipTopologyEnd();
+                }
+                else
+                {
+                    mReadOffset += triangleCount * 3 * sizeof(int);
+                }
+
+                break;
+            }
+
+            case Command::RenderSprings:
+            {
+                if (nullptr != renderContext)
+                    renderContext->RenderSprings();
+                break;
+            }
+
+            case Command::RenderStressedSprings:
+            {
+                uint64_t const count = Read<uint64_t>();
+                uint64_t const maxSprings = Read<uint64_t>();
+                if (count > maxSprings || count > (mData.size() - mReadOffset) / (2 * sizeof(int)))
+                    throw GameException("Render recording file \"" + mFilePath + "\" has an invalid stressed spring render");
+
+                if (nullptr != renderContext)
+                {
+                    renderContext->RenderStressedSpringsStart(static_cast<size_t>(maxSprings));
+                    for (uint64_t i = 0; i < count; ++i)
+                    {
+                        int const pointIndex1 = Read<int>();
+                        int const pointIndex2 = Read<int>();
+                        renderContext->RenderStressedSpring(pointIndex1, pointIndex2);
+                    }
+
+                    renderContext->RenderStressedSpringsEnd();
+                }
+                else
+                {
+                    mReadOffset += count * 2 * sizeof(int);
+                }
+
+                break;
+            }
+
+            case Command::UploadStressedSprings:
+            {
+                uint64_t const count = Read<uint64_t>();
+                uint64_t const version = Read<uint64_t>();
+                if (count > (mData.size() - mReadOffset) / (2 * sizeof(int)))
+                    throw GameException("Render recording file \"" + mFilePath + "\" is truncated");
+
+                if (nullptr != renderContext)
+                {
+                    mStressedSpringIndices.resize(static_cast<size_t>(count * 2));
+                    std::memcpy(mStressedSpringIndices.data(), mData.data() + mReadOffset, count * 2 * sizeof(int));
+                    mReadOffset += count * 2 * sizeof(int);
+
+                    renderContext->UploadStressedSprings(version, mStressedSpringIndices.data(), static_cast<size_t>(count));
+                }
+                else
+                {
+                    mReadOffset += count * 2 * sizeof(int);
+                }
+
+                break;
+            }
+
+            case Command::UpdateStressedSprings:
+            {
+                uint64_t const count = Read<uint64_t>();
+                uint64_t const springCount = Read<uint64_t>();
+                uint64_t const dirtyStart = Read<uint64_t>();
+                if (dirtyStart > springCount || count > springCount - dirtyStart || count > (mData.size() - mReadOffset) / (2 * sizeof(int)))
+                    throw GameException("Render recording file \"" + mFilePath + "\" has an invalid stressed spring update");
+
+                if (nullptr != renderContext)
+                {
+                    // Springs past the old size are always in the dirty range
+                    mStressedSpringIndices.resize(static_cast<size_t>(springCount * 2));
+                    std::memcpy(
+                        mStressedSpringIndices.data() + dirtyStart * 2,
+                        mData.data() + mReadOffset,
+                        count * 2 * sizeof(int));
+                    mReadOffset += count * 2 * sizeof(int);
+
+                    renderContext->UpdateStressedSprings(
+                        mStressedSpringIndices.data(),
+                        static_cast<size_t>(springCount),
+                        static_cast<size_t>(dirtyStart),
+                        static_cast<size_t>(dirtyStart + count));
+                }
+                else
+                {
+                    mReadOffset += count * 2 * sizeof(int);
+                }
+
+                break;
+            }
+
+            case Command::RenderUploadedStressedSprings:
+            {
+                if (nullptr != renderContext)
+                    renderContext->RenderStressedSprings();
+                break;
+            }
+
+            case Command::RenderShipTriangles:
+            {
+                if (nullptr != renderContext)
+                    renderContext->RenderShipTriangles();
+                break;
+            }
+
+            case Command::RenderEnd:
+            {
+                if (nullptr != renderContext)
+                    renderContext->RenderEnd();
+                return true;
+            }
+
+            default:
+            {
+                throw GameException(
+                    "Render recording file \"" + mFilePath + "\" has an unknown command "
+                    + std::to_string(static_cast<int>(command)) + " at offset " + std::to_string(mReadOffset - 1));
+            }
+        }
+    }
+}
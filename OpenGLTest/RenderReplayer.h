@@ -0,0 +1,91 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "RenderContext.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/*
+ * Plays back a file written by RenderRecorder against a RenderContext, one
+ * frame at a time, issuing the same calls with the same arguments - and thus
+ * needing neither a World nor the GUI.
+ *
+ * The whole file is loaded in memory upfront, so that replaying does no I/O.
+ */
+class RenderReplayer
+{
+public:
+
+    /*
+     * Loads the specified file and validates its header, throwing a
+     * GameException if it's not a render recording.
+     */
+    RenderReplayer(std::string const & filePath);
+
+    /*
+     * The number of frames in the recording.
+     */
+    size_t GetFrameCount() const
+    {
+        return mFrameCount;
+    }
+
+    /*
+     * Issues the calls of the next frame, up to and including RenderEnd; returns
+     * false when there are no frames left.
+     */
+    bool ReplayFrame(RenderContext & renderContext);
+
+    /*
+     * Starts over from the first frame.
+     */
+    void Rewind()
+    {
+        mReadOffset = mFirstFrameOffset;
+    }
+
+private:
+
+    template<typename T>
+    inline T Read()
+    {
+        CheckAvailable(sizeof(T));
+
+        T value;
+        std::memcpy(&value, mData.data() + mReadOffset, sizeof(T));
+        mReadOffset += sizeof(T);
+        return value;
+    }
+
+    void CheckAvailable(size_t size) const;
+
+    uint64_t ReadElementCount(size_t elementSize);
+
+    // Copies the next count elements of indices out of the file, suitably aligned
+    int const * ReadIndices(size_t count);
+
+    // Validates the next frame and, when a render context is given, issues its calls
+    bool ProcessFrame(RenderContext * renderContext);
+
+private:
+
+    std::string const mFilePath;
+    std::vector<uint8_t> mData;
+    size_t mFirstFrameOffset;
+    size_t mReadOffset;
+    size_t mFrameCount;
+
+    std::vector<int> mIndices;
+
+    // The stressed spring set as of the last upload or update, which the
+    // updates only carry the dirty range of
+    std::vector<int> mStressedSpringIndices;
+};
@@ -0,0 +1,69 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "ShipIndexChunks.h"
+
+#include <algorithm>
+
+bool MakeShipIndexChunks(
+    int const * indices,
+    size_t primitiveCount,
+    size_t indicesPerPrimitive,
+    std::vector<uint16_t> & chunkIndices,
+    std::vector<ShipIndexChunk> & chunks)
+{
+    static constexpr size_t MaxChunkPoints = 0x10000u;
+
+    chunkIndices.resize(primitiveCount * indicesPerPrimitive);
+    chunks.clear();
+
+    // The first chunk starts at the first point, which makes for a single
+    // chunk whenever the ship has less than 64K points; subsequent chunks
+    // start at the lowest point of their first primitive
+    ShipIndexChunk chunk(0u, 0u, 0u);
+
+    for (size_t p = 0; p < primitiveCount; ++p)
+    {
+        int const * primitiveIndices = &(indices[p * indicesPerPrimitive]);
+
+        size_t minPoint = static_cast<size_t>(primitiveIndices[0]);
+        size_t maxPoint = minPoint;
+        for (size_t i = 1; i < indicesPerPrimitive; ++i)
+        {
+            minPoint = std::min(minPoint, static_cast<size_t>(primitiveIndices[i]));
+            maxPoint = std::max(maxPoint, static_cast<size_t>(primitiveIndices[i]));
+        }
+
+        if (maxPoint - minPoint >= MaxChunkPoints)
+        {
+            return false;
+        }
+
+        if (minPoint < chunk.BasePoint || maxPoint - chunk.BasePoint >= MaxChunkPoints)
+        {
+            // Start a new chunk
+            if (chunk.IndexCount > 0)
+            {
+                chunks.push_back(chunk);
+            }
+
+            chunk = ShipIndexChunk(minPoint, p * indicesPerPrimitive, 0u);
+        }
+
+        for (size_t i = 0; i < indicesPerPrimitive; ++i)
+        {
+            chunkIndices[p * indicesPerPrimitive + i] = static_cast<uint16_t>(static_cast<size_t>(primitiveIndices[i]) - chunk.BasePoint);
+        }
+
+        chunk.IndexCount += indicesPerPrimitive;
+    }
+
+    if (chunk.IndexCount > 0)
+    {
+        chunks.push_back(chunk);
+    }
+
+    return true;
+}
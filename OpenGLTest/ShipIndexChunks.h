@@ -0,0 +1,42 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// A run of indices, relative to the ship point at which the run starts
+struct ShipIndexChunk
+{
+    size_t BasePoint;
+    size_t FirstIndex;
+    size_t IndexCount;
+
+    ShipIndexChunk(
+        size_t basePoint,
+        size_t firstIndex,
+        size_t indexCount)
+        : BasePoint(basePoint)
+        , FirstIndex(firstIndex)
+        , IndexCount(indexCount)
+    {}
+};
+
+/*
+ * Narrows the indices of the primitives - springs or triangles - to 16 bits, by
+ * splitting them into runs that each reference less than 64K points; returns
+ * false if some primitive alone spans more points than that.
+ *
+ * Shared by RenderContext and NullRenderContext, so that the latter costs the
+ * same as the former's topology uploads.
+ */
+bool MakeShipIndexChunks(
+    int const * indices,
+    size_t primitiveCount,
+    size_t indicesPerPrimitive,
+    std::vector<uint16_t> & chunkIndices,
+    std::vector<ShipIndexChunk> & chunks);
@@ -0,0 +1,184 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "Bitset.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/*
+ * A set of springs, kept as a dense array of their point indices - two per
+ * spring, laid out as the render context's spring elements - together with
+ * whether the set changed since the last ClearDirty(), and the range of the
+ * array that changed.
+ *
+ * Adding and removing are O(1): springs are added at the end of the array, and
+ * a removed spring is replaced by the last one, hence the order of the springs
+ * in the array is arbitrary.
+ *
+ * All springs only cost one bit, telling whether they're in the set; only the
+ * springs in the set have their slot in the array mapped.
+ */
+class SpringSet
+{
+public:
+
+    /*
+     * Springs are identified by their index, which must be less than the
+     * specified count.
+     */
+    explicit SpringSet(size_t springCount)
+        : mElements()
+        , mElementSprings()
+        , mMembership(springCount)
+        , mSpringSlots()
+        , mDirtyStart(std::numeric_limits<size_t>::max())
+        , mDirtyEnd(0u)
+        , mIsDirty(false)
+    {}
+
+    SpringSet(SpringSet const & other) = delete;
+    SpringSet & operator=(SpringSet const & other) = delete;
+
+    size_t GetSize() const
+    {
+        return mElements.size();
+    }
+
+    size_t GetAllocationSize() const
+    {
+        // The map's buckets, and its nodes with their next pointer
+        return mElements.capacity() * sizeof(Element)
+            + mElementSprings.capacity() * sizeof(uint32_t)
+            + mMembership.GetAllocationSize()
+            + mSpringSlots.bucket_count() * sizeof(void *)
+            + mSpringSlots.size() * (sizeof(void *) + sizeof(std::pair<uint32_t const, uint32_t>));
+    }
+
+    bool Contains(size_t springIndex) const
+    {
+        return mMembership.Test(springIndex);
+    }
+
+    void Add(
+        size_t springIndex,
+        int pointAIndex,
+        int pointBIndex)
+    {
+        assert(!Contains(springIndex));
+
+        size_t const slot = mElements.size();
+
+        mElements.push_back({ pointAIndex, pointBIndex });
+        mElementSprings.push_back(static_cast<uint32_t>(springIndex));
+        mMembership.Set(springIndex, true);
+        mSpringSlots.emplace(static_cast<uint32_t>(springIndex), static_cast<uint32_t>(slot));
+
+        MarkDirty(slot);
+    }
+
+    void Remove(size_t springIndex)
+    {
+        assert(Contains(springIndex));
+
+        auto const slotIt = mSpringSlots.find(static_cast<uint32_t>(springIndex));
+        assert(slotIt != mSpringSlots.end());
+
+        size_t const slot = slotIt->second;
+        size_t const lastSlot = mElements.size() - 1;
+
+        mSpringSlots.erase(slotIt);
+
+        if (slot != lastSlot)
+        {
+            // Move the last spring into the hole
+            mElements[slot] = mElements[lastSlot];
+            mElementSprings[slot] = mElementSprings[lastSlot];
+            mSpringSlots[mElementSprings[slot]] = static_cast<uint32_t>(slot);
+
+            MarkDirty(slot);
+        }
+
+        mElements.pop_back();
+        mElementSprings.pop_back();
+        mMembership.Set(springIndex, false);
+
+        mIsDirty = true;
+    }
+
+    /*
+     * The point indices of the springs in the set, two per spring.
+     */
+    int const * GetPointIndices() const
+    {
+        return reinterpret_cast<int const *>(mElements.data());
+    }
+
+    //
+    // The dirty range only covers the changed springs that are still in the
+    // array, hence it's empty when the set only lost its last springs
+    //
+
+    bool IsDirty() const
+    {
+        return mIsDirty;
+    }
+
+    size_t GetDirtyStart() const
+    {
+        return std::min(mDirtyStart, GetDirtyEnd());
+    }
+
+    size_t GetDirtyEnd() const
+    {
+        return std::min(mDirtyEnd, mElements.size());
+    }
+
+    void ClearDirty()
+    {
+        mDirtyStart = std::numeric_limits<size_t>::max();
+        mDirtyEnd = 0u;
+        mIsDirty = false;
+    }
+
+private:
+
+    void MarkDirty(size_t slot)
+    {
+        mDirtyStart = std::min(mDirtyStart, slot);
+        mDirtyEnd = std::max(mDirtyEnd, slot + 1);
+        mIsDirty = true;
+    }
+
+private:
+
+    struct Element
+    {
+        int PointAIndex;
+        int PointBIndex;
+    };
+
+    static_assert(sizeof(Element) == 2 * sizeof(int), "Elements must be packed");
+
+    // The springs in the set, and the index of each
+    std::vector<Element> mElements;
+    std::vector<uint32_t> mElementSprings;
+
+    // Whether each spring is in the set, and the slot in the array of those that are
+    Bitset mMembership;
+    std::unordered_map<uint32_t, uint32_t> mSpringSlots;
+
+    size_t mDirtyStart;
+    size_t mDirtyEnd;
+    bool mIsDirty;
+};
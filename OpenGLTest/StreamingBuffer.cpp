@@ -0,0 +1,240 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "StreamingBuffer.h"
+
+#include "GameException.h"
+
+#include <cassert>
+#include <cstring>
+
+StreamingBuffer::StreamingBuffer(size_t segmentCount)
+    : mVBO(0u)
+    , mSegmentCount(segmentCount)
+    , mUseMapBufferRange(GLAD_GL_ARB_map_buffer_range && GLAD_GL_ARB_sync)
+    , mBufferSize(0u)
+    , mSegmentSize(0u)
+    , mCurrentSegment(0u)
+    , mSegmentFences()
+    , mMappedSize(0u)
+    , mStagingBuffer()
+    , mStagingBufferSize(0u)
+    , mStatistics()
+{
+    assert(segmentCount >= 1u && segmentCount <= MaxSegmentCount);
+
+    for (size_t s = 0; s < MaxSegmentCount; ++s)
+    {
+        mSegmentFences[s] = nullptr;
+    }
+
+    glGenBuffers(1, &mVBO);
+}
+
+StreamingBuffer::~StreamingBuffer()
+{
+    for (size_t s = 0; s < MaxSegmentCount; ++s)
+    {
+        if (nullptr != mSegmentFences[s])
+        {
+            glDeleteSync(mSegmentFences[s]);
+        }
+    }
+
+    if (mVBO != 0)
+    {
+        glDeleteBuffers(1, &mVBO);
+    }
+}
+
+void * StreamingBuffer::MapSegment(size_t size)
+{
+    assert(0u == mMappedSize);
+
+    mMappedSize = size;
+
+    if (!mUseMapBufferRange)
+    {
+        //
+        // Orphaning path: data goes to staging first
+        //
+
+        if (size > mStagingBufferSize)
+        {
+            mStagingBuffer.reset();
+            mStagingBuffer.reset(new uint8_t[size]);
+            mStagingBufferSize = size;
+
+            ++mStatistics.StagingAllocations;
+        }
+
+        return mStagingBuffer.get();
+    }
+
+    //
+    // Ring path
+    //
+
+    if (size > mSegmentSize)
+    {
+        // Round up so that segments start at nicely-aligned offsets
+        Reallocate((size + 255u) & ~static_cast<size_t>(255u));
+    }
+    else
+    {
+        mCurrentSegment = (mCurrentSegment + 1) % mSegmentCount;
+    }
+
+    WaitForSegment(mCurrentSegment);
+
+    // A single segment is never fenced; invalidating it all lets the driver
+    // hand us a new store rather than sync with the GPU
+    GLbitfield const mapAccess = (mSegmentCount > 1u)
+        ? GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT
+        : GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT;
+
+    glBindBuffer(GL_ARRAY_BUFFER, mVBO);
+    void * segmentPtr = glMapBufferRange(
+        GL_ARRAY_BUFFER,
+        static_cast<GLintptr>(GetCurrentSegmentOffset()),
+        static_cast<GLsizeiptr>(size),
+        mapAccess);
+
+    if (nullptr == segmentPtr)
+    {
+        throw GameException("ERROR mapping streaming buffer segment");
+    }
+
+    return segmentPtr;
+}
+
+void StreamingBuffer::UnmapSegment()
+{
+    glBindBuffer(GL_ARRAY_BUFFER, mVBO);
+
+    if (!mUseMapBufferRange)
+    {
+        // Orphan the old store, so that we don't have to wait for the GPU to be done with it
+        glBufferData(GL_ARRAY_BUFFER, mMappedSize, nullptr, GetUsage());
+        glBufferSubData(GL_ARRAY_BUFFER, 0, mMappedSize, mStagingBuffer.get());
+
+        mBufferSize = mMappedSize;
+        ++mStatistics.BufferAllocations;
+    }
+    else
+    {
+        // The store might only be lost on exotic events (e.g. screen mode changes),
+        // in which case we'll just live with one bad frame
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+    }
+
+    mStatistics.BytesStreamed += mMappedSize;
+
+    mMappedSize = 0u;
+}
+
+void StreamingBuffer::UploadSegment(std::initializer_list<SegmentPart> parts)
+{
+    assert(0u == mMappedSize);
+
+    size_t size = 0u;
+    for (SegmentPart const & part : parts)
+    {
+        size += part.Size;
+    }
+
+    if (!mUseMapBufferRange)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, mVBO);
+
+        // Orphan the old store, as UnmapSegment() does
+        glBufferData(GL_ARRAY_BUFFER, size, nullptr, GetUsage());
+
+        size_t offset = 0u;
+        for (SegmentPart const & part : parts)
+        {
+            glBufferSubData(GL_ARRAY_BUFFER, offset, part.Size, part.Data);
+            offset += part.Size;
+        }
+
+        mBufferSize = size;
+        ++mStatistics.BufferAllocations;
+
+        mStatistics.BytesStreamed += size;
+
+        return;
+    }
+
+    uint8_t * segmentPtr = static_cast<uint8_t *>(MapSegment(size));
+
+    for (SegmentPart const & part : parts)
+    {
+        std::memcpy(segmentPtr, part.Data, part.Size);
+        segmentPtr += part.Size;
+    }
+
+    UnmapSegment();
+}
+
+void StreamingBuffer::FenceCurrentSegment()
+{
+    if (!mUseMapBufferRange || 1u == mSegmentCount || 0u == mSegmentSize)
+    {
+        return;
+    }
+
+    if (nullptr != mSegmentFences[mCurrentSegment])
+    {
+        glDeleteSync(mSegmentFences[mCurrentSegment]);
+    }
+
+    mSegmentFences[mCurrentSegment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void StreamingBuffer::Reallocate(size_t segmentSize)
+{
+    // The old store goes away together with all of its pending reads
+    for (size_t s = 0; s < mSegmentCount; ++s)
+    {
+        if (nullptr != mSegmentFences[s])
+        {
+            glDeleteSync(mSegmentFences[s]);
+            mSegmentFences[s] = nullptr;
+        }
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, mVBO);
+    glBufferData(GL_ARRAY_BUFFER, mSegmentCount * segmentSize, nullptr, GetUsage());
+
+    mBufferSize = mSegmentCount * segmentSize;
+    ++mStatistics.BufferAllocations;
+
+    mSegmentSize = segmentSize;
+    mCurrentSegment = 0u;
+}
+
+void StreamingBuffer::WaitForSegment(size_t segment)
+{
+    GLsync fence = mSegmentFences[segment];
+    if (nullptr == fence)
+    {
+        return;
+    }
+
+    // Poll first, so that we only count actual stalls
+    GLenum waitResult = glClientWaitSync(fence, 0, 0);
+    if (GL_TIMEOUT_EXPIRED == waitResult)
+    {
+        ++mStatistics.Stalls;
+
+        do
+        {
+            waitResult = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+        } while (GL_TIMEOUT_EXPIRED == waitResult);
+    }
+
+    glDeleteSync(fence);
+    mSegmentFences[segment] = nullptr;
+}
@@ -0,0 +1,169 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "OpenGLTest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+
+/*
+ * A vertex buffer whose contents are re-written (streamed) as a whole.
+ *
+ * When ARB_map_buffer_range and ARB_sync are available the buffer object is
+ * split into a ring of segments; each upload goes to the next segment via an
+ * unsynchronized map, and a fence guards each segment against being overwritten
+ * while the GPU is still reading it.
+ *
+ * With a single segment - for data that only changes once in a while - there
+ * is just one copy of the data: each upload invalidates the whole store, which
+ * lets the driver give us a new one instead of waiting for the GPU.
+ *
+ * On plain OpenGL 2.0 we fall back to orphaning the buffer store and uploading
+ * with glBufferSubData.
+ */
+class StreamingBuffer
+{
+public:
+
+    struct Statistics
+    {
+        uint64_t BytesStreamed;
+        uint64_t Stalls;
+
+        // The times the buffer object's store, and the staging buffer, were (re)allocated
+        uint64_t BufferAllocations;
+        uint64_t StagingAllocations;
+
+        Statistics()
+            : BytesStreamed(0u)
+            , Stalls(0u)
+            , BufferAllocations(0u)
+            , StagingAllocations(0u)
+        {}
+    };
+
+    // A piece of caller-owned memory to upload
+    struct SegmentPart
+    {
+        void const * Data;
+        size_t Size;
+    };
+
+    static constexpr size_t MaxSegmentCount = 3;
+
+public:
+
+    /*
+     * Data re-written every frame wants a ring of segments - up to MaxSegmentCount -
+     * while data re-written once in a while wants a single one.
+     */
+    explicit StreamingBuffer(size_t segmentCount);
+
+    ~StreamingBuffer();
+
+    StreamingBuffer(StreamingBuffer const & other) = delete;
+    StreamingBuffer & operator=(StreamingBuffer const & other) = delete;
+
+    /*
+     * Returns a pointer to memory that may receive exactly the specified number of bytes;
+     * the memory is only valid until UnmapSegment() is invoked.
+     */
+    void * MapSegment(size_t size);
+
+    /*
+     * Makes the data written since the last MapSegment() available to the GPU.
+     */
+    void UnmapSegment();
+
+    /*
+     * Uploads the specified parts, back to back, as the next segment: copied straight
+     * into the mapped segment, or handed as-is to glBufferSubData when falling back,
+     * without going through the staging buffer.
+     */
+    void UploadSegment(std::initializer_list<SegmentPart> parts);
+
+    /*
+     * Protects the current segment from being overwritten until all the GL commands
+     * issued so far have completed. To be invoked after the last draw call sourcing
+     * from the current segment.
+     */
+    void FenceCurrentSegment();
+
+    GLuint GetVBO() const
+    {
+        return mVBO;
+    }
+
+    /*
+     * The offset, in bytes, at which the most recently uploaded data starts in the VBO.
+     */
+    size_t GetCurrentSegmentOffset() const
+    {
+        return mCurrentSegment * mSegmentSize;
+    }
+
+    /*
+     * The size, in bytes, of the buffer object's store.
+     */
+    size_t GetBufferSize() const
+    {
+        return mBufferSize;
+    }
+
+    /*
+     * The size, in bytes, of the CPU staging buffer; zero unless falling back to glBufferSubData.
+     */
+    size_t GetStagingBufferSize() const
+    {
+        return mStagingBufferSize;
+    }
+
+    bool IsUsingMapBufferRange() const
+    {
+        return mUseMapBufferRange;
+    }
+
+    Statistics const & GetStatistics() const
+    {
+        return mStatistics;
+    }
+
+private:
+
+    void Reallocate(size_t segmentSize);
+
+    void WaitForSegment(size_t segment);
+
+    GLenum GetUsage() const
+    {
+        return mSegmentCount > 1u ? GL_STREAM_DRAW : GL_STATIC_DRAW;
+    }
+
+private:
+
+    GLuint mVBO;
+
+    size_t const mSegmentCount;
+    bool const mUseMapBufferRange;
+
+    size_t mBufferSize;
+
+    size_t mSegmentSize;
+    size_t mCurrentSegment;
+    GLsync mSegmentFences[MaxSegmentCount];
+
+    // Size of the upload currently in progress
+    size_t mMappedSize;
+
+    // Only used when falling back to glBufferSubData
+    std::unique_ptr<uint8_t[]> mStagingBuffer;
+    size_t mStagingBufferSize;
+
+    Statistics mStatistics;
+};
@@ -0,0 +1,600 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "World.h"
+
+#include "GameException.h"
+#include "NullRenderContext.h"
+#include "Profiler.h"
+#include "RenderRecorder.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+
+namespace /* anonymous */ {
+
+    // Land and water extend at least this much on either side of the origin,
+    // and at least as much as the ship is wide
+    constexpr int MinSceneHalfWidth = 140;
+
+    constexpr float WaveHeight = 2.0f;
+    constexpr float SeaDepth = 60.0f;
+    constexpr int WaterSurfaceSlicesPerMeter = 10;
+}
+
+World::World(
+    int worldWidth,
+    int worldHeight)
+    : mLandParameters()
+    , mLandVersion(0u)
+    , mWorldWidth(worldWidth)
+    , mWorldHeight(worldHeight)
+    , mPoints(GetValidatedPointCount(worldWidth, worldHeight))
+    , mSprings()
+    , mTriangles()
+    , mStressedSprings(CalculateSpringCount(worldWidth, worldHeight))
+    , mStressedSpringsVersion(0u)
+    , mArePointsDirty(false)
+    , mShipTopologyVersion(0u)
+    , mWaterSurfaceVersion(0u)
+    , mIsWaterTransparent(false)
+    , mDrawOnlyPoints(false)
+    , mUseGpuWater(true)
+    , mCurrentTime(0.0f)
+{
+    CreateWorld();
+}
+
+bool World::IsValidWorldSize(
+    int worldWidth,
+    int worldHeight)
+{
+    return worldWidth > 0
+        && worldHeight > 0
+        && static_cast<size_t>(worldWidth) * static_cast<size_t>(worldHeight) <= MaxPointCount;
+}
+
+size_t World::GetValidatedPointCount(
+    int worldWidth,
+    int worldHeight)
+{
+    // Before allocating anything
+    if (!IsValidWorldSize(worldWidth, worldHeight))
+    {
+        throw GameException(
+            "Invalid world size " + std::to_string(worldWidth) + "x" + std::to_string(worldHeight)
+            + ": it must have at least one point and at most " + std::to_string(MaxPointCount));
+    }
+
+    return static_cast<size_t>(worldWidth) * static_cast<size_t>(worldHeight);
+}
+
+size_t World::CalculateSpringCount(
+    int worldWidth,
+    int worldHeight)
+{
+    // Each point has a spring to its E, NE, N and NW neighbours, when it has them
+    size_t const w = static_cast<size_t>(worldWidth);
+    size_t const h = static_cast<size_t>(worldHeight);
+    return (w - 1) * h + (w - 1) * (h - 1) + w * (h - 1) + (w - 1) * (h - 1);
+}
+
+bool World::ParseWorldSize(
+    std::string const & str,
+    int & worldWidth,
+    int & worldHeight)
+{
+    char * end;
+    long const width = strtol(str.c_str(), &end, 10);
+    if (end == str.c_str() || (*end != 'x' && *end != 'X'))
+        return false;
+
+    char const * const heightStart = end + 1;
+    long const height = strtol(heightStart, &end, 10);
+    if (end == heightStart || *end != '\0')
+        return false;
+
+    if (width > static_cast<long>(MaxPointCount) || height > static_cast<long>(MaxPointCount)
+        || !IsValidWorldSize(static_cast<int>(width), static_cast<int>(height)))
+        return false;
+
+    worldWidth = static_cast<int>(width);
+    worldHeight = static_cast<int>(height);
+    return true;
+}
+
+bool World::GetScaledWorldSize(
+    float pointScale,
+    int & worldWidth,
+    int & worldHeight)
+{
+    if (!(pointScale > 0.0f) || pointScale > static_cast<float>(MaxPointCount))
+        return false;
+
+    float const sideScale = sqrtf(pointScale);
+    int const width = std::max(1, static_cast<int>(lroundf(static_cast<float>(DefaultWorldWidth) * sideScale)));
+    int const height = std::max(1, static_cast<int>(lroundf(static_cast<float>(DefaultWorldHeight) * sideScale)));
+
+    if (!IsValidWorldSize(width, height))
+        return false;
+
+    worldWidth = width;
+    worldHeight = height;
+    return true;
+}
+
+void World::Update()
+{
+    mCurrentTime += 0.2f;
+}
+
+template<typename TRenderContext>
+void World::Render(TRenderContext & renderContext)
+{
+    renderContext.RenderStart();
+
+    //
+    // Land
+    //
+
+    {
+        PROFILE_SCOPE("Land");
+
+        if (renderContext.GetLandVersion() != mLandVersion)
+        {
+            UploadLand(renderContext);
+        }
+
+        renderContext.RenderLand();
+    }
+
+    if (mIsWaterTransparent)
+    {
+        RenderWater(renderContext);
+    }
+
+    //
+    // Upload points
+    //
+
+    {
+        PROFILE_SCOPE("Point Upload");
+
+        if (mArePointsDirty)
+        {
+            renderContext.InvalidateShipPointPositions();
+            renderContext.InvalidateShipPointColours();
+
+            mArePointsDirty = false;
+        }
+
+        if (renderContext.AreShipPointPositionsDirty())
+        {
+            UploadShipPointPositions(renderContext);
+        }
+
+        if (renderContext.AreShipPointColoursDirty())
+        {
+            UploadShipPointColours(renderContext);
+        }
+    }
+
+
+    if (mDrawOnlyPoints)
+    {
+        PROFILE_SCOPE("Points");
+
+        renderContext.RenderShipPoints();
+    }
+    else
+    {
+        //
+        // Springs, with the topology - only uploaded when it changes
+        //
+
+        {
+            PROFILE_SCOPE("Springs");
+
+            if (renderContext.GetShipTopologyVersion() != mShipTopologyVersion)
+            {
+                UploadShipTopology(renderContext);
+            }
+
+            renderContext.RenderSprings();
+        }
+
+        {
+            PROFILE_SCOPE("Stressed Springs");
+
+            RenderStressedSprings(renderContext);
+        }
+
+
+        //
+        // Triangles
+        //
+
+        {
+            PROFILE_SCOPE("Triangles");
+
+            renderContext.RenderShipTriangles();
+        }
+    }
+
+    if (!mIsWaterTransparent)
+    {
+        RenderWater(renderContext);
+    }
+
+    //
+    // End
+    //
+
+    {
+        PROFILE_SCOPE("RenderEnd");
+
+        renderContext.RenderEnd();
+    }
+}
+
+// The points, springs and triangles are already laid out as the render context's
+// streams and buffers, hence they go up in bulk
+
+template<typename TRenderContext>
+void World::UploadShipPointPositions(TRenderContext & renderContext)
+{
+    renderContext.UploadShipPointPositions(
+        mPoints.GetPositionBuffer(),
+        mPoints.GetCount());
+}
+
+template<typename TRenderContext>
+void World::UploadShipPointColours(TRenderContext & renderContext)
+{
+    // Shading with the ambient light happens in the shaders
+    renderContext.UploadShipPointColours(
+        mPoints.GetColourBuffer(),
+        mPoints.GetWaterBuffer(),
+        mPoints.GetLightBuffer(),
+        mPoints.GetCount());
+}
+
+template<typename TRenderContext>
+void World::UploadShipTopology(TRenderContext & renderContext)
+{
+    renderContext.UploadShipTopology(
+        mShipTopologyVersion,
+        mPoints.GetCount(),
+        reinterpret_cast<int const *>(mSprings.data()),
+        mSprings.size(),
+        reinterpret_cast<int const *>(mTriangles.data()),
+        mTriangles.size());
+}
+
+template<typename TRenderContext>
+void World::RenderStressedSprings(TRenderContext & renderContext)
+{
+    if (renderContext.GetStressedSpringsVersion() != mStressedSpringsVersion)
+    {
+        renderContext.UploadStressedSprings(
+            mStressedSpringsVersion,
+            mStressedSprings.GetPointIndices(),
+            mStressedSprings.GetSize());
+
+        mStressedSprings.ClearDirty();
+    }
+    else if (mStressedSprings.IsDirty())
+    {
+        renderContext.UpdateStressedSprings(
+            mStressedSprings.GetPointIndices(),
+            mStressedSprings.GetSize(),
+            mStressedSprings.GetDirtyStart(),
+            mStressedSprings.GetDirtyEnd());
+
+        mStressedSprings.ClearDirty();
+    }
+
+    renderContext.RenderStressedSprings();
+}
+
+void World::SetSpringStressed(
+    size_t springIndex,
+    bool isStressed)
+{
+    if (isStressed == mStressedSprings.Contains(springIndex))
+        return;
+
+    if (isStressed)
+    {
+        mStressedSprings.Add(
+            springIndex,
+            mSprings[springIndex].PointAIndex,
+            mSprings[springIndex].PointBIndex);
+    }
+    else
+    {
+        mStressedSprings.Remove(springIndex);
+    }
+}
+
+void World::CreateWorld()
+{
+    //
+    // Set land
+    //
+
+    float const sceneHalfWidth = static_cast<float>(std::max(MinSceneHalfWidth, mWorldWidth));
+
+    mLandParameters.Left = -sceneHalfWidth;
+    mLandParameters.Right = sceneHalfWidth;
+    mLandParameters.SeaDepth = 60.0f;
+    mLandParameters.SlicesPerMeter = 4.0f;
+
+    // Make sure the new land gets uploaded
+    ++mLandVersion;
+
+    // ...and the water grid
+    ++mWaterSurfaceVersion;
+
+    // 
+    // Create points
+    //
+
+    for (int c = 0; c < mWorldWidth; ++c)
+    {
+        float x = static_cast<float>(c) - static_cast<float>(mWorldWidth) / 2.0f;
+
+        for (int r = 0; r < mWorldHeight; ++r)
+        {            
+            float y = static_cast<float>(r) - static_cast<float>(mWorldHeight) / 2.0f;
+
+            int const pointIndex = GetPointIndex(c, r);
+
+            vec2f & position = mPoints.GetPosition(pointIndex);
+            vec3f & colour = mPoints.GetColour(pointIndex);
+            float & water = mPoints.GetWater(pointIndex);
+            float & light = mPoints.GetLight(pointIndex);
+
+            position = vec2f(x, y);
+
+            if (r == 0 || r == mWorldHeight - 1 || c == 0 || c == mWorldWidth - 1
+                || r == mWorldHeight / 2 || c == mWorldWidth / 2)
+            {
+                colour = vec3f(0.2f, 0.2f, 0.2f);
+            }
+            else if ((r == mWorldHeight / 3 || r == mWorldHeight * 2 / 3)
+                && (c >= mWorldWidth / 3 && c <= mWorldWidth * 2 / 3))
+            {
+                colour = vec3f(0.6f, 0.2f, 0.2f);
+            }
+            else if ((r >= mWorldHeight / 3 && r <= mWorldHeight * 2 / 3)
+                && (c == mWorldWidth / 3 || c == mWorldWidth * 2 / 3))
+            {
+                colour = vec3f(0.6f, 0.2f, 0.2f);
+            }
+            else
+            {
+                colour = vec3f(0.9f, 0.9f, 0.9f);
+            }
+
+
+            float distance = position.length();
+
+            if (distance > 20.0f && distance < 40.0f)
+            {
+                float d = (distance - 30.0f) / 10.0f; // -1 <= d <= 1
+                water = 1.0f - (d * d);
+            }
+            else
+            {
+                water = 0.0f;
+            }
+
+            if (distance == 0)
+            {
+                light = 1.0f;
+            }
+            else if (distance < 10.0f)
+            {
+                light = 1.0f / (distance * distance);
+            }
+            else
+            { 
+                light = 0.0f;
+            }
+        }
+    }
+
+    // Make sure the new points get uploaded
+    mArePointsDirty = true;
+
+
+    //
+    // Create springs and triangles
+    //
+
+    // Make sure the new topology, and its stressed springs, get uploaded
+    ++mShipTopologyVersion;
+    ++mStressedSpringsVersion;
+
+    // Reserving spares large worlds the copies of repeated growth; there are at
+    // most four triangles per point, and we trim the slack at the end
+    mSprings.reserve(CalculateSpringCount(mWorldWidth, mWorldHeight));
+    mTriangles.reserve(4 * mPoints.GetCount());
+
+    static const int Directions[8][2] = {
+        { 1,  0 },	// E
+        { 1, -1 },	// NE
+        { 0, -1 },	// N
+        { -1, -1 },	// NW
+        { -1,  0 },	// W
+        { -1,  1 },	// SW
+        { 0,  1 },	// S
+        { 1,  1 }	// SE
+    };
+
+    for (int c = 0; c < mWorldWidth; ++c)
+    {
+        for (int r = 0; r < mWorldHeight; ++r)
+        {
+            int const pA = GetPointIndex(c, r);
+
+            for (int i = 0; i < 4; ++i)
+            {
+                int adjc1 = c + Directions[i][0];
+                int adjr1 = r + Directions[i][1];
+                
+                if (adjc1 >= 0 && adjc1 < mWorldWidth && adjr1 >= 0)
+                {
+                    //
+                    // Create a<->b spring
+                    // 
+
+                    int const pB = GetPointIndex(adjc1, adjr1);
+
+                    bool isStressed = (0 == (adjc1 % 10) && 0 == (adjr1 % 10));
+
+                    if (isStressed)
+                    {
+                        mStressedSprings.Add(mSprings.size(), pA, pB);
+                    }
+
+                    mSprings.emplace_back(pA, pB);
+
+                    int adjc2 = c + Directions[i + 1][0];
+                    int adjr2 = r + Directions[i + 1][1];
+                    
+                    if (adjc2 >= 0 && adjc2 < mWorldWidth && adjr2 >= 0)
+                    {
+                        if (adjc2 >= 20 && adjc2 < mWorldWidth - 20 && adjr2 >= 20 && adjr2 < mWorldHeight - 20)
+                        {
+                            //
+                            // Create a<->b<->c triangle
+                            //
+
+                            int const pC = GetPointIndex(adjc2, adjr2);
+
+                            mTriangles.emplace_back(pA, pB, pC);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    assert(mSprings.size() == CalculateSpringCount(mWorldWidth, mWorldHeight));
+
+    mTriangles.shrink_to_fit();
+}
+
+template<typename TRenderContext>
+void World::UploadLand(TRenderContext & renderContext)
+{
+    size_t const slices = static_cast<size_t>((mLandParameters.Right - mLandParameters.Left) * mLandParameters.SlicesPerMeter);
+
+    renderContext.UploadLandStart(mLandVersion, slices);
+
+    for (size_t i = 0; i <= slices; ++i)
+    {
+        float const x = mLandParameters.Left + static_cast<float>(i) / mLandParameters.SlicesPerMeter;
+
+        renderContext.UploadLand(
+            x,
+            -mLandParameters.SeaDepth,
+            GetOceanFloorHeight(x, mLandParameters.SeaDepth));
+    }
+
+    renderContext.UploadLandEnd();
+}
+
+float World::GetOceanFloorHeight(float x, float seaDepth) const
+{
+    float const c1 = sinf(x * 0.05f) * 6.f;
+    float const c2 = sinf(x * 0.15f) * 2.f;
+    float const c3 = sin(x * 0.011f) * 25.f;
+    return -seaDepth + (c1 + c2 - c3) + 33.f;
+}
+
+float World::GetWaterHeight(float x, float waveHeight) const
+{
+    float const c1 = sinf(x * 0.1f + mCurrentTime) * 0.5f;
+    float const c2 = sinf(x * 0.3f - mCurrentTime * 1.1f) * 0.3f;
+    return (c1 + c2) * waveHeight;
+}
+
+template<typename TRenderContext>
+void World::UploadWaterSurface(TRenderContext & renderContext)
+{
+    size_t const slices = static_cast<size_t>((mLandParameters.Right - mLandParameters.Left) * WaterSurfaceSlicesPerMeter);
+
+    renderContext.UploadWaterSurfaceStart(mWaterSurfaceVersion, slices);
+
+    for (size_t i = 0; i <= slices; ++i)
+    {
+        renderContext.UploadWaterSurface(
+            mLandParameters.Left + static_cast<float>(i) / static_cast<float>(WaterSurfaceSlicesPerMeter),
+            -SeaDepth);
+    }
+
+    renderContext.UploadWaterSurfaceEnd();
+}
+
+template<typename TRenderContext>
+void World::RenderWater(TRenderContext & renderContext)
+{
+    PROFILE_SCOPE("Water");
+
+    //
+    // Water
+    //
+
+    if (mUseGpuWater)
+    {
+        // The grid is static, the waves are calculated by the vertex shader
+        if (renderContext.GetWaterSurfaceVersion() != mWaterSurfaceVersion)
+        {
+            UploadWaterSurface(renderContext);
+        }
+
+        renderContext.RenderWaterSurface(mCurrentTime, WaveHeight);
+
+        return;
+    }
+
+    // Water spans the land
+    int const leftWater = static_cast<int>(mLandParameters.Left);
+    int const rightWater = static_cast<int>(mLandParameters.Right);
+
+    renderContext.RenderWaterStart(static_cast<size_t>(rightWater - leftWater));
+
+    for (int i = leftWater; i <= rightWater; ++i)
+    {
+        renderContext.RenderWater(
+            static_cast<float>(i),
+            -SeaDepth,
+            GetWaterHeight(static_cast<float>(i), WaveHeight));
+    }
+
+    renderContext.RenderWaterEnd();
+}
+
+//
+// Explicit instantiations
+//
+
+#define INSTANTIATE_WORLD_RENDERING(TRenderContext) \
+    template void World::Render<TRenderContext>(TRenderContext &); \
+    template void World::UploadLand<TRenderContext>(TRenderContext &); \
+    template void World::UploadShipPointPositions<TRenderContext>(TRenderContext &); \
+    template void World::UploadShipPointColours<TRenderContext>(TRenderContext &); \
+    template void World::UploadShipTopology<TRenderContext>(TRenderContext &); \
+    template void World::RenderStressedSprings<TRenderContext>(TRenderContext &); \
+    template void World::UploadWaterSurface<TRenderContext>(TRenderContext &); \
+    template void World::RenderWater<TRenderContext>(TRenderContext &);
+
+INSTANTIATE_WORLD_RENDERING(RenderContext)
+INSTANTIATE_WORLD_RENDERING(NullRenderContext)
+INSTANTIATE_WORLD_RENDERING(RenderRecorder)
@@ -0,0 +1,319 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "Points.h"
+#include "SpringSet.h"
+#include "RenderContext.h"
+#include "Vectors.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+ * The test scene: a ship made of a grid of points, springs and triangles,
+ * floating in a sea above a strip of land.
+ *
+ * The world renders itself with a RenderContext, so that the GUI and the
+ * benchmark go through the very same sequence of passes. Rendering is a
+ * template on the render context so that the same loops may also be driven
+ * against a NullRenderContext, which needs no OpenGL, or a RenderRecorder,
+ * which captures them.
+ */
+class World
+{
+public:
+
+    /*
+     * Throws GameException if the size is not valid - see IsValidWorldSize().
+     */
+    World(
+        int worldWidth = DefaultWorldWidth,
+        int worldHeight = DefaultWorldHeight);
+
+    World(World const & other) = delete;
+    World & operator=(World const & other) = delete;
+
+    /*
+     * Advances the world by one frame.
+     */
+    void Update();
+
+    /*
+     * Renders one frame, from RenderStart() to RenderEnd(); the ambient light
+     * intensity is up to the caller.
+     */
+    template<typename TRenderContext>
+    void Render(TRenderContext & renderContext);
+
+    //
+    // The stages of Render(), each running its loop unconditionally; exposed
+    // so that their CPU cost may be measured in isolation.
+    //
+
+    template<typename TRenderContext>
+    void UploadLand(TRenderContext & renderContext);
+
+    template<typename TRenderContext>
+    void UploadShipPointPositions(TRenderContext & renderContext);
+
+    template<typename TRenderContext>
+    void UploadShipPointColours(TRenderContext & renderContext);
+
+    template<typename TRenderContext>
+    void UploadShipTopology(TRenderContext & renderContext);
+
+    template<typename TRenderContext>
+    void RenderStressedSprings(TRenderContext & renderContext);
+
+    template<typename TRenderContext>
+    void UploadWaterSurface(TRenderContext & renderContext);
+
+    template<typename TRenderContext>
+    void RenderWater(TRenderContext & renderContext);
+
+public:
+
+    static constexpr int DefaultWorldWidth = 140;
+    static constexpr int DefaultWorldHeight = 110;
+
+    // Keeps the index counts of all draw calls well within a GLsizei
+    static constexpr size_t MaxPointCount = 16u * 1024u * 1024u;
+
+    static bool IsValidWorldSize(
+        int worldWidth,
+        int worldHeight);
+
+    /*
+     * Parses "WIDTHxHEIGHT"; returns false if malformed or not valid.
+     */
+    static bool ParseWorldSize(
+        std::string const & str,
+        int & worldWidth,
+        int & worldHeight);
+
+    /*
+     * The size of a world with the specified multiple of the default world's points,
+     * and the same aspect ratio; returns false if not valid.
+     */
+    static bool GetScaledWorldSize(
+        float pointScale,
+        int & worldWidth,
+        int & worldHeight);
+
+    int GetWorldWidth() const
+    {
+        return mWorldWidth;
+    }
+
+    int GetWorldHeight() const
+    {
+        return mWorldHeight;
+    }
+
+    /*
+     * The zoom at which the whole ship fits the view as the default ship does at zoom 1.
+     */
+    float GetFittingZoom() const
+    {
+        return std::min(
+            1.0f,
+            std::min(
+                static_cast<float>(DefaultWorldWidth) / static_cast<float>(mWorldWidth),
+                static_cast<float>(DefaultWorldHeight) / static_cast<float>(mWorldHeight)));
+    }
+
+    size_t GetPointCount() const
+    {
+        return mPoints.GetCount();
+    }
+
+    size_t GetSpringCount() const
+    {
+        return mSprings.size();
+    }
+
+    size_t GetTriangleCount() const
+    {
+        return mTriangles.size();
+    }
+
+    size_t GetStressedSpringCount() const
+    {
+        return mStressedSprings.GetSize();
+    }
+
+    bool IsSpringStressed(size_t springIndex) const
+    {
+        return mStressedSprings.Contains(springIndex);
+    }
+
+    /*
+     * Only the springs whose stress changes get re-uploaded, at the next Render().
+     */
+    void SetSpringStressed(
+        size_t springIndex,
+        bool isStressed);
+
+    /*
+     * The memory held by the world's containers, in bytes; that is, by their
+     * capacity, not just by the elements in use.
+     */
+    struct MemoryUsage
+    {
+        size_t PointBytes;
+        size_t SpringBytes;
+        size_t TriangleBytes;
+
+        size_t GetTotalBytes() const
+        {
+            return PointBytes + SpringBytes + TriangleBytes;
+        }
+    };
+
+    MemoryUsage GetMemoryUsage() const
+    {
+        return MemoryUsage{
+            mPoints.GetAllocationSize(),
+            mSprings.capacity() * sizeof(Spring) + mStressedSprings.GetAllocationSize(),
+            mTriangles.capacity() * sizeof(Triangle) };
+    }
+
+    bool GetIsWaterTransparent() const
+    {
+        return mIsWaterTransparent;
+    }
+
+    void SetIsWaterTransparent(bool isWaterTransparent)
+    {
+        mIsWaterTransparent = isWaterTransparent;
+    }
+
+    bool GetDrawOnlyPoints() const
+    {
+        return mDrawOnlyPoints;
+    }
+
+    void SetDrawOnlyPoints(bool drawOnlyPoints)
+    {
+        mDrawOnlyPoints = drawOnlyPoints;
+    }
+
+    bool GetUseGpuWater() const
+    {
+        return mUseGpuWater;
+    }
+
+    void SetUseGpuWater(bool useGpuWater)
+    {
+        mUseGpuWater = useGpuWater;
+    }
+
+private:
+
+    void CreateWorld();
+    float GetOceanFloorHeight(float x, float seaDepth) const;
+    float GetWaterHeight(float x, float waveHeight) const;
+
+private:
+
+    struct LandParameters
+    {
+        float Left;
+        float Right;
+        float SeaDepth;
+        float SlicesPerMeter;
+
+        LandParameters()
+            : Left(0.0f)
+            , Right(0.0f)
+            , SeaDepth(0.0f)
+            , SlicesPerMeter(1.0f)
+        {}
+    };
+
+    LandParameters mLandParameters;
+
+    // Bumped whenever the land parameters change
+    uint64_t mLandVersion;
+
+    // Springs and triangles are just the indices of their points, laid out as
+    // the render context's spring and triangle elements
+    struct Spring
+    {
+        int PointAIndex;
+        int PointBIndex;
+
+        Spring(int a, int b)
+            : PointAIndex(a)
+            , PointBIndex(b)
+        {}
+    };
+
+    static_assert(sizeof(Spring) == 2 * sizeof(int), "Springs must be packed");
+
+    struct Triangle
+    {
+        int PointAIndex;
+        int PointBIndex;
+        int PointCIndex;
+
+        Triangle(int a, int b, int c)
+            : PointAIndex(a)
+            , PointBIndex(b)
+            , PointCIndex(c)
+        {}
+    };
+
+    static_assert(sizeof(Triangle) == 3 * sizeof(int), "Triangles must be packed");
+
+    static size_t GetValidatedPointCount(
+        int worldWidth,
+        int worldHeight);
+
+    static size_t CalculateSpringCount(
+        int worldWidth,
+        int worldHeight);
+
+    inline int GetPointIndex(int c, int r) const
+    {
+        assert(c >= 0 && c < mWorldWidth && r >= 0 && r < mWorldHeight);
+        return c * mWorldHeight + r;
+    }
+
+    int const mWorldWidth;
+    int const mWorldHeight;
+
+    // Column by column
+    Points mPoints;
+    std::vector<Spring> mSprings;
+    std::vector<Triangle> mTriangles;
+
+    // Changes are tracked until they're handed to the render context
+    SpringSet mStressedSprings;
+
+    // Bumped whenever the stressed springs are re-created
+    uint64_t mStressedSpringsVersion;
+
+    // Set whenever the points change, until they're handed to the render context
+    bool mArePointsDirty;
+
+    // Bumped whenever springs or triangles change
+    uint64_t mShipTopologyVersion;
+
+    // Bumped whenever the water grid needs to be re-uploaded
+    uint64_t mWaterSurfaceVersion;
+
+    bool mIsWaterTransparent;
+    bool mDrawOnlyPoints;
+    bool mUseGpuWater;
+
+    float mCurrentTime;
+};
@@ -0,0 +1,785 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "BenchReport.h"
+#include "OffscreenContext.h"
+
+#include "FrameStatistics.h"
+#include "GameException.h"
+#include "Profiler.h"
+#include "RenderContext.h"
+#include "RenderRecorder.h"
+#include "RenderReplayer.h"
+#include "World.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace /* anonymous */ {
+
+    struct BenchOptions
+    {
+        size_t Frames;
+        size_t WarmupFrames;
+        int Width;
+        int Height;
+        float HitchBudget;
+        bool IsWaterTransparent;
+        bool DrawOnlyPoints;
+        bool UseGpuWater;
+        bool ShowPerformanceOverlay;
+        int WorldWidth;
+        int WorldHeight;
+        std::vector<float> WorldSweepScales;
+        std::string TraceFilePath;
+        std::string RecordFilePath;
+        std::string ReplayFilePath;
+        std::string Scenario;
+        std::string SaveBaselineFilePath;
+        std::string BaselineFilePath;
+        std::vector<MetricTolerance> Tolerances;
+
+        BenchOptions()
+            : Frames(300u)
+            , WarmupFrames(10u)
+            , Width(1280)
+            , Height(720)
+            , HitchBudget(1000.0f / 60.0f)
+            , IsWaterTransparent(false)
+            , DrawOnlyPoints(false)
+            , UseGpuWater(true)
+            , ShowPerformanceOverlay(false)
+            , WorldWidth(World::DefaultWorldWidth)
+            , WorldHeight(World::DefaultWorldHeight)
+            , WorldSweepScales()
+            , TraceFilePath()
+            , RecordFilePath()
+            , ReplayFilePath()
+            , Scenario()
+            , SaveBaselineFilePath()
+            , BaselineFilePath()
+            , Tolerances()
+        {}
+    };
+
+    void PrintUsage()
+    {
+        fprintf(stderr,
+            "Usage: OpenGLTestBench [options]\n"
+            "  --frames N           Number of measured frames (default: 300)\n"
+            "  --warmup N           Number of frames to run before measuring (default: 10)\n"
+            "  --width N            Framebuffer width (default: 1280)\n"
+            "  --height N           Framebuffer height (default: 720)\n"
+            "  --hitch-budget MS    Frames taking longer count as hitches (default: 16.67)\n"
+            "  --transparent-water  Render water before the ship\n"
+            "  --points-only        Render only the ship points\n"
+            "  --cpu-water          Calculate the water surface on the CPU\n"
+            "  --overlay            Draw the performance overlay\n"
+            "  --world-size WxH     Number of columns and rows of ship points (default: 140x110)\n"
+            "  --world-scale F      Use F times the default number of ship points, with the same aspect ratio\n"
+            "  --world-sweep F,...  Run the frames once for each of the point scales, printing a CSV line\n"
+            "                       with the frame times and sizes of each instead of the report\n"
+            "  --trace FILE         Write the profiled scopes as trace-event JSON (needs OPENGLTEST_PROFILE)\n"
+            "  --record FILE        Record the render commands of all frames to FILE\n"
+            "  --replay FILE        Replay the render commands recorded in FILE instead of rendering the world;\n"
+            "                       the recording's frames are played once, and the ones after the warmup are\n"
+            "                       measured, up to --frames\n"
+            "  --scenario NAME      Name of the scenario in the report (default: derived from the options)\n"
+            "  --save-baseline FILE Also write the report to FILE, as a baseline for later runs\n"
+            "  --baseline FILE      Compare with the baseline in FILE, exiting with 3 on regressions\n"
+            "  --tolerance P=PCT[,ABS]\n"
+            "                       Metrics under path P regress when they grow by more than PCT percent and\n"
+            "                       by more than ABS; may be repeated (default: frame_ms.mean/p50=10,0.05,\n"
+            "                       frame_ms.p95=15,0.05, cpu_ms=10,0.02, gpu_ms=15,0.02, counters_per_frame=0)\n");
+    }
+
+    bool ParseOptions(
+        int argc,
+        char ** argv,
+        BenchOptions & options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string const arg(argv[i]);
+
+            if ((arg == "--frames" || arg == "--warmup" || arg == "--width" || arg == "--height") && i + 1 < argc)
+            {
+                long const value = strtol(argv[++i], nullptr, 10);
+                if (value <= 0 && arg != "--warmup")
+                    return false;
+
+                if (arg == "--frames")
+                    options.Frames = static_cast<size_t>(value);
+                else if (arg == "--warmup")
+                    options.WarmupFrames = static_cast<size_t>(std::max(value, 0L));
+                else if (arg == "--width")
+                    options.Width = static_cast<int>(value);
+                else
+                    options.Height = static_cast<int>(value);
+            }
+            else if (arg == "--hitch-budget" && i + 1 < argc)
+            {
+                float const value = strtof(argv[++i], nullptr);
+                if (value <= 0.0f)
+                    return false;
+
+                options.HitchBudget = value;
+            }
+            else if (arg == "--transparent-water")
+            {
+                options.IsWaterTransparent = true;
+            }
+            else if (arg == "--points-only")
+            {
+                options.DrawOnlyPoints = true;
+            }
+            else if (arg == "--cpu-water")
+            {
+                options.UseGpuWater = false;
+            }
+            else if (arg == "--overlay")
+            {
+                options.ShowPerformanceOverlay = true;
+            }
+            else if (arg == "--world-size" && i + 1 < argc)
+            {
+                if (!World::ParseWorldSize(argv[++i], options.WorldWidth, options.WorldHeight))
+                    return false;
+            }
+            else if (arg == "--world-scale" && i + 1 < argc)
+            {
+                if (!World::GetScaledWorldSize(strtof(argv[++i], nullptr), options.WorldWidth, options.WorldHeight))
+                    return false;
+            }
+            else if (arg == "--world-sweep" && i + 1 < argc)
+            {
+                char const * scaleStart = argv[++i];
+                while (true)
+                {
+                    char * end;
+                    float const scale = strtof(scaleStart, &end);
+
+                    int worldWidth;
+                    int worldHeight;
+                    if (end == scaleStart || !World::GetScaledWorldSize(scale, worldWidth, worldHeight))
+                        return false;
+
+                    options.WorldSweepScales.push_back(scale);
+
+                    if (*end == '\0')
+                        break;
+
+                    if (*end != ',')
+                        return false;
+
+                    scaleStart = end + 1;
+                }
+            }
+            else if (arg == "--trace" && i + 1 < argc)
+            {
+                options.TraceFilePath = argv[++i];
+            }
+            else if (arg == "--record" && i + 1 < argc)
+            {
+                options.RecordFilePath = argv[++i];
+            }
+            else if (arg == "--replay" && i + 1 < argc)
+            {
+                options.ReplayFilePath = argv[++i];
+            }
+            else if (arg == "--scenario" && i + 1 < argc)
+            {
+                options.Scenario = argv[++i];
+            }
+            else if (arg == "--save-baseline" && i + 1 < argc)
+            {
+                options.SaveBaselineFilePath = argv[++i];
+            }
+            else if (arg == "--baseline" && i + 1 < argc)
+            {
+                options.BaselineFilePath = argv[++i];
+            }
+            else if (arg == "--tolerance" && i + 1 < argc)
+            {
+                MetricTolerance tolerance("", 0.0, 0.0);
+                if (!MetricTolerance::Parse(argv[++i], tolerance))
+                    return false;
+
+                options.Tolerances.push_back(tolerance);
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        if (!options.RecordFilePath.empty() && !options.ReplayFilePath.empty())
+            return false;
+
+        // A sweep makes no single report
+        if (!options.WorldSweepScales.empty()
+            && (!options.RecordFilePath.empty() || !options.ReplayFilePath.empty()
+                || !options.SaveBaselineFilePath.empty() || !options.BaselineFilePath.empty()))
+            return false;
+
+        if (options.Scenario.empty())
+        {
+            if (!options.ReplayFilePath.empty())
+            {
+                // The file name, without its directory
+                size_t const separatorPosition = options.ReplayFilePath.find_last_of("/\\");
+                options.Scenario = "replay:" + options.ReplayFilePath.substr(separatorPosition == std::string::npos ? 0 : separatorPosition + 1);
+            }
+            else
+            {
+                options.Scenario = "default";
+                if (options.IsWaterTransparent)
+                    options.Scenario += "+transparent-water";
+                if (options.DrawOnlyPoints)
+                    options.Scenario += "+points-only";
+                if (!options.UseGpuWater)
+                    options.Scenario += "+cpu-water";
+                if (options.ShowPerformanceOverlay)
+                    options.Scenario += "+overlay";
+                if (options.WorldWidth != World::DefaultWorldWidth || options.WorldHeight != World::DefaultWorldHeight)
+                    options.Scenario += "+world-" + std::to_string(options.WorldWidth) + "x" + std::to_string(options.WorldHeight);
+            }
+        }
+
+        std::replace(options.Scenario.begin(), options.Scenario.end(), '"', '\'');
+        std::replace(options.Scenario.begin(), options.Scenario.end(), '\\', '/');
+
+        return true;
+    }
+
+    void AppendFormat(
+        std::string & str,
+        char const * format,
+        ...)
+    {
+        char buffer[1024];
+
+        va_list args;
+        va_start(args, format);
+        vsnprintf(buffer, sizeof(buffer), format, args);
+        va_end(args);
+
+        str += buffer;
+    }
+
+    void AppendBufferMemory(
+        std::string & report,
+        char const * name,
+        RenderContext::BufferMemory const & memory,
+        bool isLast)
+    {
+        AppendFormat(report, "      \"%s\": {\n", name);
+        AppendFormat(report, "        \"staging_bytes\": %zu,\n", memory.StagingBytes);
+        AppendFormat(report, "        \"peak_staging_bytes\": %zu,\n", memory.PeakStagingBytes);
+        AppendFormat(report, "        \"staging_allocations\": %llu,\n", static_cast<unsigned long long>(memory.StagingAllocations));
+        AppendFormat(report, "        \"gpu_bytes\": %zu,\n", memory.GpuBytes);
+        AppendFormat(report, "        \"peak_gpu_bytes\": %zu,\n", memory.PeakGpuBytes);
+        AppendFormat(report, "        \"gpu_allocations\": %llu\n", static_cast<unsigned long long>(memory.GpuAllocations));
+        AppendFormat(report, "      }%s\n", isLast ? "" : ",");
+    }
+
+    /*
+     * Renders the warmup frames and the measured frames, either of the world - also
+     * recorded when there's a recorder - or of the replayed recording; returns the
+     * profiler time at which the measured frames started.
+     */
+    int64_t RunFrames(
+        BenchOptions const & options,
+        size_t measuredFrames,
+        RenderContext & renderContext,
+        World * world,
+        RenderRecorder * renderRecorder,
+        RenderReplayer * renderReplayer,
+        FrameStatistics & frameStatistics,
+        RenderContext::FrameCounters & totalFrameCounters)
+    {
+        int64_t measureStartTime = 0;
+
+        for (size_t frame = 0; frame < options.WarmupFrames + measuredFrames; ++frame)
+        {
+            if (frame == options.WarmupFrames)
+                measureStartTime = Profiler::Now();
+
+            auto const frameStartTime = std::chrono::steady_clock::now();
+
+            PROFILE_SCOPE("Frame");
+
+            if (nullptr != renderReplayer)
+            {
+                renderReplayer->ReplayFrame(renderContext);
+            }
+            else
+            {
+                // Same as the GUI's ambient light cycle, on a simulated 60 FPS clock
+                float const phase = static_cast<float>(frame) * 1000.0f / 60.0f;
+                renderContext.SetAmbientLightIntensity((1.0f + sinf(phase / 2500.0f)) / 2.0f);
+
+                if (nullptr != renderRecorder)
+                    world->Render(*renderRecorder);
+                else
+                    world->Render(renderContext);
+            }
+
+            // Stands in for SwapBuffers
+            {
+                PROFILE_SCOPE("SwapBuffers");
+
+                glFinish();
+            }
+
+            auto const frameEndTime = std::chrono::steady_clock::now();
+
+            if (nullptr != world)
+                world->Update();
+
+            if (frame >= options.WarmupFrames)
+            {
+                frameStatistics.AddFrameTime(std::chrono::duration<float, std::milli>(frameEndTime - frameStartTime).count());
+                totalFrameCounters += renderContext.GetLastFrameCounters();
+            }
+        }
+
+        GLenum const glError = glGetError();
+        if (GL_NO_ERROR != glError)
+        {
+            throw GameException("OpenGL error " + std::to_string(glError) + " while rendering");
+        }
+
+        return measureStartTime;
+    }
+
+    /*
+     * Runs the frames with worlds of increasing size, printing one CSV line per world
+     * as soon as it's done - for charting the frame time against the mesh size.
+     */
+    void RunWorldSweep(BenchOptions const & options)
+    {
+        printf("point_scale,world_width,world_height,points,springs,triangles,"
+            "frame_ms_mean,frame_ms_p50,frame_ms_p95,frame_ms_max,gpu_ms,peak_gpu_buffer_bytes,world_bytes\n");
+        fflush(stdout);
+
+        for (float const scale : options.WorldSweepScales)
+        {
+            int worldWidth;
+            int worldHeight;
+            bool const isValidScale = World::GetScaledWorldSize(scale, worldWidth, worldHeight);
+            assert(isValidScale);
+            (void)isValidScale;
+
+            // A new render context for each world, so that nothing carries over
+            std::unique_ptr<RenderContext> renderContext = std::make_unique<RenderContext>();
+            renderContext->SetCanvasSize(options.Width, options.Height);
+            renderContext->SetShowPerformanceOverlay(options.ShowPerformanceOverlay);
+
+            World world(worldWidth, worldHeight);
+            world.SetIsWaterTransparent(options.IsWaterTransparent);
+            world.SetDrawOnlyPoints(options.DrawOnlyPoints);
+            world.SetUseGpuWater(options.UseGpuWater);
+
+            renderContext->SetZoom(world.GetFittingZoom());
+
+            FrameStatistics frameStatistics(options.Frames, options.HitchBudget);
+            RenderContext::FrameCounters totalFrameCounters;
+
+            RunFrames(
+                options,
+                options.Frames,
+                *renderContext,
+                &world,
+                nullptr,
+                nullptr,
+                frameStatistics,
+                totalFrameCounters);
+
+            FrameStatistics::Summary const frameSummary = frameStatistics.GetSummary();
+
+            // Blank without timer queries
+            std::string gpuTime;
+            if (renderContext->IsGpuTimingSupported())
+            {
+                float totalGpuTime = 0.0f;
+                for (size_t p = 0; p < static_cast<size_t>(RenderContext::RenderPass::_Count); ++p)
+                {
+                    totalGpuTime += renderContext->GetAverageGpuPassTime(static_cast<RenderContext::RenderPass>(p));
+                }
+
+                AppendFormat(gpuTime, "%.4f", totalGpuTime);
+            }
+
+            printf("%g,%d,%d,%zu,%zu,%zu,%.4f,%.4f,%.4f,%.4f,%s,%zu,%zu\n",
+                scale,
+                worldWidth,
+                worldHeight,
+                world.GetPointCount(),
+                world.GetSpringCount(),
+                world.GetTriangleCount(),
+                frameSummary.Mean,
+                frameSummary.P50,
+                frameSummary.P95,
+                frameSummary.Max,
+                gpuTime.c_str(),
+                renderContext->GetTotalBufferMemory().PeakGpuBytes,
+                world.GetMemoryUsage().GetTotalBytes());
+            fflush(stdout);
+        }
+    }
+
+    /*
+     * Prints the comparison to stderr; returns false if any metric regressed.
+     */
+    bool PrintComparison(std::vector<MetricComparison> const & comparisons)
+    {
+        size_t regressions = 0;
+
+        fprintf(stderr, "%-48s %12s %12s %9s %14s  %s\n", "metric", "baseline", "current", "change", "tolerance", "result");
+
+        for (MetricComparison const & comparison : comparisons)
+        {
+            char const * result;
+            switch (comparison.Result)
+            {
+                case MetricComparison::ResultType::Improved:
+                    result = "improved";
+                    break;
+
+                case MetricComparison::ResultType::Regressed:
+                    result = "REGRESSED";
+                    ++regressions;
+                    break;
+
+                case MetricComparison::ResultType::Missing:
+                    result = "missing";
+                    break;
+
+                default:
+                    result = "ok";
+                    break;
+            }
+
+            char change[32];
+            if (comparison.Result == MetricComparison::ResultType::Missing || comparison.Baseline == 0.0)
+                snprintf(change, sizeof(change), "-");
+            else
+                snprintf(change, sizeof(change), "%+.1f%%", (comparison.Current - comparison.Baseline) / comparison.Baseline * 100.0);
+
+            char tolerance[32];
+            snprintf(tolerance, sizeof(tolerance), "%.1f%%,%g", comparison.Tolerance.Percent, comparison.Tolerance.Absolute);
+
+            fprintf(stderr, "%-48s %12.4f %12.4f %9s %14s  %s\n",
+                comparison.Metric.c_str(),
+                comparison.Baseline,
+                comparison.Current,
+                change,
+                tolerance,
+                result);
+        }
+
+        fprintf(stderr, "%zu of %zu metrics regressed\n", regressions, comparisons.size());
+
+        return regressions == 0;
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    BenchOptions options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        PrintUsage();
+        return 2;
+    }
+
+    try
+    {
+        //
+        // Initialize
+        //
+
+        OffscreenContext offscreenContext(options.Width, options.Height);
+
+        if (!options.WorldSweepScales.empty())
+        {
+            RunWorldSweep(options);
+            return 0;
+        }
+
+        std::unique_ptr<RenderContext> renderContext = std::make_unique<RenderContext>();
+        renderContext->SetCanvasSize(options.Width, options.Height);
+        renderContext->SetShowPerformanceOverlay(options.ShowPerformanceOverlay);
+
+        // Either the world is rendered - and optionally recorded - or a recording is replayed
+        std::unique_ptr<World> world;
+        std::unique_ptr<RenderRecorder> renderRecorder;
+        std::unique_ptr<RenderReplayer> renderReplayer;
+
+        size_t measuredFrames = options.Frames;
+
+        if (options.ReplayFilePath.empty())
+        {
+            world = std::make_unique<World>(options.WorldWidth, options.WorldHeight);
+            world->SetIsWaterTransparent(options.IsWaterTransparent);
+            world->SetDrawOnlyPoints(options.DrawOnlyPoints);
+            world->SetUseGpuWater(options.UseGpuWater);
+
+            // Keep the whole ship in view, as the default one is
+            renderContext->SetZoom(world->GetFittingZoom());
+
+            if (!options.RecordFilePath.empty())
+                renderRecorder = std::make_unique<RenderRecorder>(*renderContext, options.RecordFilePath);
+        }
+        else
+        {
+            renderReplayer = std::make_unique<RenderReplayer>(options.ReplayFilePath);
+
+            if (renderReplayer->GetFrameCount() <= options.WarmupFrames)
+            {
+                throw GameException(
+                    "The recording has " + std::to_string(renderReplayer->GetFrameCount())
+                    + " frames, not more than the " + std::to_string(options.WarmupFrames) + " warmup frames");
+            }
+
+            measuredFrames = std::min(measuredFrames, renderReplayer->GetFrameCount() - options.WarmupFrames);
+        }
+
+        //
+        // Run
+        //
+
+        FrameStatistics frameStatistics(measuredFrames, options.HitchBudget);
+        RenderContext::FrameCounters totalFrameCounters;
+
+        int64_t const measureStartTime = RunFrames(
+            options,
+            measuredFrames,
+            *renderContext,
+            world.get(),
+            renderRecorder.get(),
+            renderReplayer.get(),
+            frameStatistics,
+            totalFrameCounters);
+
+        //
+        // Report
+        //
+
+        if (!options.TraceFilePath.empty())
+        {
+            if (Profiler::IsCompiledIn)
+                Profiler::WriteChromeTrace(options.TraceFilePath);
+            else
+                fprintf(stderr, "WARNING: the profiler is not compiled in, no trace written\n");
+        }
+
+        FrameStatistics::Summary const frameSummary = frameStatistics.GetSummary();
+
+        std::string renderer = offscreenContext.GetRenderer();
+        std::replace(renderer.begin(), renderer.end(), '"', '\'');
+
+        std::string report;
+
+        AppendFormat(report, "{\n");
+        AppendFormat(report, "  \"scenario\": \"%s\",\n", options.Scenario.c_str());
+        AppendFormat(report, "  \"renderer\": \"%s\",\n", renderer.c_str());
+        AppendFormat(report, "  \"width\": %d,\n", options.Width);
+        AppendFormat(report, "  \"height\": %d,\n", options.Height);
+
+        if (!!world)
+        {
+            AppendFormat(report, "  \"world_width\": %d,\n", world->GetWorldWidth());
+            AppendFormat(report, "  \"world_height\": %d,\n", world->GetWorldHeight());
+            AppendFormat(report, "  \"points\": %zu,\n", world->GetPointCount());
+            AppendFormat(report, "  \"springs\": %zu,\n", world->GetSpringCount());
+            AppendFormat(report, "  \"triangles\": %zu,\n", world->GetTriangleCount());
+        }
+        else
+        {
+            std::string replayFilePath = options.ReplayFilePath;
+            std::replace(replayFilePath.begin(), replayFilePath.end(), '\\', '/');
+            std::replace(replayFilePath.begin(), replayFilePath.end(), '"', '\'');
+
+            AppendFormat(report, "  \"replay\": \"%s\",\n", replayFilePath.c_str());
+        }
+
+        AppendFormat(report, "  \"frames\": %zu,\n", frameSummary.FrameCount);
+        AppendFormat(report, "  \"hitches\": %zu,\n", frameSummary.Hitches);
+        AppendFormat(report, "  \"hitch_budget_ms\": %.4f,\n", frameSummary.HitchBudget);
+        AppendFormat(report, "  \"frame_ms\": {\n");
+        AppendFormat(report, "    \"mean\": %.4f,\n", frameSummary.Mean);
+        AppendFormat(report, "    \"min\": %.4f,\n", frameSummary.Min);
+        AppendFormat(report, "    \"p50\": %.4f,\n", frameSummary.P50);
+        AppendFormat(report, "    \"p90\": %.4f,\n", frameSummary.P90);
+        AppendFormat(report, "    \"p95\": %.4f,\n", frameSummary.P95);
+        AppendFormat(report, "    \"p99\": %.4f,\n", frameSummary.P99);
+        AppendFormat(report, "    \"max\": %.4f\n", frameSummary.Max);
+        AppendFormat(report, "  },\n");
+
+        double const frameCount = static_cast<double>(measuredFrames);
+
+        AppendFormat(report, "  \"counters_per_frame\": {\n");
+        AppendFormat(report, "    \"draw_calls\": %.2f,\n", static_cast<double>(totalFrameCounters.DrawCalls) / frameCount);
+        AppendFormat(report, "    \"program_switches\": %.2f,\n", static_cast<double>(totalFrameCounters.ProgramSwitches) / frameCount);
+        AppendFormat(report, "    \"state_changes\": %.2f,\n", static_cast<double>(totalFrameCounters.StateChanges) / frameCount);
+        AppendFormat(report, "    \"uniform_uploads\": %.2f,\n", static_cast<double>(totalFrameCounters.UniformUploads) / frameCount);
+        AppendFormat(report, "    \"attribute_setups\": %.2f,\n", static_cast<double>(totalFrameCounters.AttributeSetups) / frameCount);
+        AppendFormat(report, "    \"bytes_uploaded\": {\n");
+
+        for (size_t b = 0; b < static_cast<size_t>(RenderContext::BufferType::_Count); ++b)
+        {
+            AppendFormat(report, "      \"%s\": %.1f,\n",
+                RenderContext::GetBufferTypeName(static_cast<RenderContext::BufferType>(b)),
+                static_cast<double>(totalFrameCounters.BytesUploaded[b]) / frameCount);
+        }
+
+        AppendFormat(report, "      \"Total\": %.1f\n", static_cast<double>(totalFrameCounters.GetTotalBytesUploaded()) / frameCount);
+        AppendFormat(report, "    }\n");
+        AppendFormat(report, "  }");
+
+        // The memory at the end of the run, with peaks and allocations over the whole run
+        AppendFormat(report, ",\n");
+        AppendFormat(report, "  \"memory\": {\n");
+        AppendFormat(report, "    \"buffers\": {\n");
+
+        for (size_t b = 0; b < static_cast<size_t>(RenderContext::BufferType::_Count); ++b)
+        {
+            RenderContext::BufferType const bufferType = static_cast<RenderContext::BufferType>(b);
+
+            AppendBufferMemory(
+                report,
+                RenderContext::GetBufferTypeName(bufferType),
+                renderContext->GetBufferMemory(bufferType),
+                false);
+        }
+
+        AppendBufferMemory(report, "Total", renderContext->GetTotalBufferMemory(), true);
+        AppendFormat(report, "    }%s\n", !!world ? "," : "");
+
+        if (!!world)
+        {
+            World::MemoryUsage const worldMemoryUsage = world->GetMemoryUsage();
+
+            AppendFormat(report, "    \"world\": {\n");
+            AppendFormat(report, "      \"points_bytes\": %zu,\n", worldMemoryUsage.PointBytes);
+            AppendFormat(report, "      \"springs_bytes\": %zu,\n", worldMemoryUsage.SpringBytes);
+            AppendFormat(report, "      \"triangles_bytes\": %zu,\n", worldMemoryUsage.TriangleBytes);
+            AppendFormat(report, "      \"total_bytes\": %zu\n", worldMemoryUsage.GetTotalBytes());
+            AppendFormat(report, "    }\n");
+        }
+
+        AppendFormat(report, "  }");
+
+        if (renderContext->IsGpuTimingSupported())
+        {
+            AppendFormat(report, ",\n");
+            AppendFormat(report, "  \"gpu_ms\": {\n");
+
+            for (size_t p = 0; p < static_cast<size_t>(RenderContext::RenderPass::_Count); ++p)
+            {
+                RenderContext::RenderPass const pass = static_cast<RenderContext::RenderPass>(p);
+
+                AppendFormat(report, "    \"%s\": %.4f%s\n",
+                    RenderContext::GetRenderPassName(pass),
+                    renderContext->GetAverageGpuPassTime(pass),
+                    p + 1 < static_cast<size_t>(RenderContext::RenderPass::_Count) ? "," : "");
+            }
+
+            AppendFormat(report, "  }");
+        }
+
+        // The profiled scopes, per frame
+        if (Profiler::IsCompiledIn)
+        {
+            std::vector<Profiler::ScopeTime> const scopeTimes = Profiler::GetScopeTimes(measureStartTime);
+
+            AppendFormat(report, ",\n");
+            AppendFormat(report, "  \"cpu_ms\": {\n");
+
+            for (size_t s = 0; s < scopeTimes.size(); ++s)
+            {
+                AppendFormat(report, "    \"%s\": %.4f%s\n",
+                    scopeTimes[s].Name,
+                    static_cast<double>(scopeTimes[s].TotalTime) / 1000000.0 / frameCount,
+                    s + 1 < scopeTimes.size() ? "," : "");
+            }
+
+            AppendFormat(report, "  }");
+        }
+
+        AppendFormat(report, "\n}\n");
+
+        fputs(report.c_str(), stdout);
+
+        if (!options.SaveBaselineFilePath.empty())
+        {
+            FILE * baselineFile = fopen(options.SaveBaselineFilePath.c_str(), "w");
+            if (nullptr == baselineFile)
+            {
+                throw GameException("Cannot open baseline file \"" + options.SaveBaselineFilePath + "\" for writing");
+            }
+
+            fputs(report.c_str(), baselineFile);
+
+            bool const hasFailed = (0 != ferror(baselineFile));
+            fclose(baselineFile);
+
+            if (hasFailed)
+            {
+                throw GameException("Error writing baseline file \"" + options.SaveBaselineFilePath + "\"");
+            }
+        }
+
+        //
+        // Compare with the baseline
+        //
+
+        if (!options.BaselineFilePath.empty())
+        {
+            BenchReport const baseline = BenchReport::Load(options.BaselineFilePath);
+            BenchReport const current = BenchReport::Parse(report);
+
+            if (baseline.GetString("scenario") != options.Scenario)
+            {
+                throw GameException(
+                    "The baseline is for scenario \"" + baseline.GetString("scenario")
+                    + "\", not for \"" + options.Scenario + "\"");
+            }
+
+            if (baseline.GetNumber("width") != options.Width || baseline.GetNumber("height") != options.Height)
+            {
+                throw GameException("The baseline was taken with a different framebuffer size");
+            }
+
+            if (baseline.GetString("renderer") != renderer)
+            {
+                fprintf(stderr, "WARNING: the baseline was taken on a different renderer: %s\n", baseline.GetString("renderer").c_str());
+            }
+
+            if (!PrintComparison(CompareBenchReports(baseline, current, options.Tolerances)))
+            {
+                return 3;
+            }
+        }
+    }
+    catch (std::exception const & ex)
+    {
+        fprintf(stderr, "ERROR: %s\n", ex.what());
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,360 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "BenchReport.h"
+
+#include "GameException.h"
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+
+/*
+ * A minimal recursive-descent JSON parser, enough for the bench's own reports.
+ */
+class BenchReportParser
+{
+public:
+
+    BenchReportParser(
+        std::string const & json,
+        BenchReport & report)
+        : mJson(json)
+        , mPosition(0u)
+        , mReport(report)
+    {}
+
+    void Parse()
+    {
+        ParseValue(std::string());
+
+        SkipWhitespace();
+        if (mPosition != mJson.size())
+            Fail("unexpected trailing characters");
+    }
+
+private:
+
+    void ParseValue(std::string const & path)
+    {
+        SkipWhitespace();
+
+        if (mPosition >= mJson.size())
+            Fail("unexpected end");
+
+        char const c = mJson[mPosition];
+        if (c == '{')
+        {
+            ParseObject(path);
+        }
+        else if (c == '[')
+        {
+            ParseArray(path);
+        }
+        else if (c == '"')
+        {
+            mReport.mStrings[path] = ParseString();
+        }
+        else if (c == '-' || isdigit(static_cast<unsigned char>(c)))
+        {
+            char const * const start = mJson.c_str() + mPosition;
+            char * end;
+            double const value = strtod(start, &end);
+            mPosition += end - start;
+
+            mReport.mNumbers[path] = value;
+        }
+        else if (0 == mJson.compare(mPosition, 4, "true"))
+        {
+            mReport.mNumbers[path] = 1.0;
+            mPosition += 4;
+        }
+        else if (0 == mJson.compare(mPosition, 5, "false"))
+        {
+            mReport.mNumbers[path] = 0.0;
+            mPosition += 5;
+        }
+        else if (0 == mJson.compare(mPosition, 4, "null"))
+        {
+            mPosition += 4;
+        }
+        else
+        {
+            Fail("unexpected character");
+        }
+    }
+
+    void ParseObject(std::string const & path)
+    {
+        Expect('{');
+
+        SkipWhitespace();
+        if (Peek() == '}')
+        {
+            ++mPosition;
+            return;
+        }
+
+        while (true)
+        {
+            SkipWhitespace();
+            std::string const key = ParseString();
+
+            Expect(':');
+            ParseValue(path.empty() ? key : path + "." + key);
+
+            SkipWhitespace();
+            if (Peek() == ',')
+            {
+                ++mPosition;
+                continue;
+            }
+
+            Expect('}');
+            return;
+        }
+    }
+
+    void ParseArray(std::string const & path)
+    {
+        Expect('[');
+
+        SkipWhitespace();
+        if (Peek() == ']')
+        {
+            ++mPosition;
+            return;
+        }
+
+        for (size_t i = 0; ; ++i)
+        {
+            ParseValue(path + "[" + std::to_string(i) + "]");
+
+            SkipWhitespace();
+            if (Peek() == ',')
+            {
+                ++mPosition;
+                continue;
+            }
+
+            Expect(']');
+            return;
+        }
+    }
+
+    std::string ParseString()
+    {
+        Expect('"');
+
+        std::string str;
+        while (true)
+        {
+            if (mPosition >= mJson.size())
+                Fail("unterminated string");
+
+            char c = mJson[mPosition++];
+            if (c == '"')
+                return str;
+
+            if (c == '\\')
+            {
+                if (mPosition >= mJson.size())
+                    Fail("unterminated string");
+
+                c = mJson[mPosition++];
+                if (c == 'n')
+                    c = '\n';
+                else if (c == 't')
+                    c = '\t';
+            }
+
+            str.push_back(c);
+        }
+    }
+
+    void SkipWhitespace()
+    {
+        while (mPosition < mJson.size() && isspace(static_cast<unsigned char>(mJson[mPosition])))
+            ++mPosition;
+    }
+
+    char Peek() const
+    {
+        return mPosition < mJson.size() ? mJson[mPosition] : '\0';
+    }
+
+    void Expect(char c)
+    {
+        SkipWhitespace();
+        if (Peek() != c)
+            Fail(std::string("expected '") + c + "'");
+
+        ++mPosition;
+    }
+
+    [[noreturn]] void Fail(std::string const & message) const
+    {
+        throw GameException("Invalid bench report: " + message + " at offset " + std::to_string(mPosition));
+    }
+
+private:
+
+    std::string const & mJson;
+    size_t mPosition;
+    BenchReport & mReport;
+};
+
+BenchReport BenchReport::Parse(std::string const & json)
+{
+    BenchReport report;
+
+    BenchReportParser parser(json, report);
+    parser.Parse();
+
+    return report;
+}
+
+BenchReport BenchReport::Load(std::string const & filePath)
+{
+    FILE * file = fopen(filePath.c_str(), "r");
+    if (nullptr == file)
+    {
+        throw GameException("Cannot open bench report \"" + filePath + "\"");
+    }
+
+    std::string json;
+    char chunk[4096];
+    size_t readBytes;
+    while ((readBytes = fread(chunk, 1, sizeof(chunk), file)) > 0)
+    {
+        json.append(chunk, readBytes);
+    }
+
+    fclose(file);
+
+    return Parse(json);
+}
+
+bool MetricTolerance::Parse(
+    std::string const & str,
+    MetricTolerance & tolerance)
+{
+    size_t const equalsPosition = str.find('=');
+    if (equalsPosition == std::string::npos || equalsPosition == 0)
+        return false;
+
+    char * end;
+    double const percent = strtod(str.c_str() + equalsPosition + 1, &end);
+    if (end == str.c_str() + equalsPosition + 1 || percent < 0.0)
+        return false;
+
+    double absolute = -1.0;
+    if (*end == ',')
+    {
+        char const * const absoluteStart = end + 1;
+        absolute = strtod(absoluteStart, &end);
+        if (end == absoluteStart || absolute < 0.0)
+            return false;
+    }
+
+    if (*end != '\0')
+        return false;
+
+    tolerance = MetricTolerance(str.substr(0, equalsPosition), percent, absolute);
+    return true;
+}
+
+std::vector<MetricTolerance> MetricTolerance::GetDefaults()
+{
+    return {
+        MetricTolerance("frame_ms.mean", 10.0, 0.05),
+        MetricTolerance("frame_ms.p50", 10.0, 0.05),
+        MetricTolerance("frame_ms.p95", 15.0, 0.05),
+        MetricTolerance("cpu_ms", 10.0, 0.02),
+        MetricTolerance("gpu_ms", 15.0, 0.02),
+        MetricTolerance("counters_per_frame", 0.0, 0.0)
+    };
+}
+
+namespace /* anonymous */ {
+
+    MetricTolerance const * FindTolerance(
+        std::string const & metric,
+        std::vector<MetricTolerance> const & tolerances)
+    {
+        MetricTolerance const * bestTolerance = nullptr;
+
+        for (MetricTolerance const & tolerance : tolerances)
+        {
+            // The prefix must end at a path component boundary
+            bool const isMatch =
+                0 == metric.compare(0, tolerance.Prefix.size(), tolerance.Prefix)
+                && (metric.size() == tolerance.Prefix.size() || metric[tolerance.Prefix.size()] == '.');
+
+            if (isMatch && (nullptr == bestTolerance || tolerance.Prefix.size() > bestTolerance->Prefix.size()))
+            {
+                bestTolerance = &tolerance;
+            }
+        }
+
+        return bestTolerance;
+    }
+}
+
+std::vector<MetricComparison> CompareBenchReports(
+    BenchReport const & baseline,
+    BenchReport const & current,
+    std::vector<MetricTolerance> const & tolerances)
+{
+    std::vector<MetricTolerance> const defaultTolerances = MetricTolerance::GetDefaults();
+
+    std::vector<MetricComparison> comparisons;
+
+    for (auto const & baselineMetric : baseline.GetNumbers())
+    {
+        MetricTolerance const * const defaultTolerance = FindTolerance(baselineMetric.first, defaultTolerances);
+
+        MetricTolerance const * tolerance = FindTolerance(baselineMetric.first, tolerances);
+        if (nullptr == tolerance)
+            tolerance = defaultTolerance;
+
+        if (nullptr == tolerance)
+            continue;
+
+        double const baselineValue = baselineMetric.second;
+
+        MetricComparison comparison{
+            baselineMetric.first,
+            baselineValue,
+            0.0,
+            *tolerance,
+            MetricComparison::ResultType::Unchanged };
+
+        if (comparison.Tolerance.Absolute < 0.0)
+            comparison.Tolerance.Absolute = (nullptr != defaultTolerance) ? defaultTolerance->Absolute : 0.0;
+
+        if (!current.HasNumber(baselineMetric.first))
+        {
+            comparison.Result = MetricComparison::ResultType::Missing;
+        }
+        else
+        {
+            double const currentValue = current.GetNumber(baselineMetric.first);
+            comparison.Current = currentValue;
+
+            double const delta = currentValue - baselineValue;
+            double const relativeTolerance = baselineValue * comparison.Tolerance.Percent / 100.0;
+
+            if (delta > relativeTolerance && delta > comparison.Tolerance.Absolute)
+                comparison.Result = MetricComparison::ResultType::Regressed;
+            else if (-delta > relativeTolerance && -delta > comparison.Tolerance.Absolute)
+                comparison.Result = MetricComparison::ResultType::Improved;
+        }
+
+        comparisons.push_back(comparison);
+    }
+
+    return comparisons;
+}
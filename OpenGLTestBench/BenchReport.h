@@ -0,0 +1,123 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+/*
+ * The JSON report of a benchmark run, flattened into the values of its leaves,
+ * each keyed by its path - e.g. "frame_ms.p50" or "gpu_ms.Springs".
+ *
+ * Used to compare a run against a baseline saved from an earlier run.
+ */
+class BenchReport
+{
+public:
+
+    /*
+     * Parses a report; throws GameException if it's not valid JSON.
+     */
+    static BenchReport Parse(std::string const & json);
+
+    static BenchReport Load(std::string const & filePath);
+
+    std::map<std::string, double> const & GetNumbers() const
+    {
+        return mNumbers;
+    }
+
+    std::string GetString(std::string const & path) const
+    {
+        auto const it = mStrings.find(path);
+        return it != mStrings.end() ? it->second : std::string();
+    }
+
+    bool HasNumber(std::string const & path) const
+    {
+        return mNumbers.count(path) > 0;
+    }
+
+    double GetNumber(std::string const & path) const
+    {
+        auto const it = mNumbers.find(path);
+        return it != mNumbers.end() ? it->second : 0.0;
+    }
+
+private:
+
+    friend class BenchReportParser;
+
+    std::map<std::string, double> mNumbers;
+    std::map<std::string, std::string> mStrings;
+};
+
+/*
+ * How much a metric - or all the metrics under a path prefix - may grow over
+ * its baseline before it counts as a regression: both by more than the
+ * percentage and by more than the absolute amount.
+ *
+ * All the metrics compared are lower-is-better.
+ */
+struct MetricTolerance
+{
+    std::string Prefix;
+    double Percent;
+    double Absolute;
+
+    MetricTolerance(
+        std::string const & prefix,
+        double percent,
+        double absolute)
+        : Prefix(prefix)
+        , Percent(percent)
+        , Absolute(absolute)
+    {}
+
+    /*
+     * Parses "PREFIX=PERCENT[,ABSOLUTE]"; returns false if malformed. Without
+     * an absolute amount, the one of the metric's default tolerance applies.
+     */
+    static bool Parse(
+        std::string const & str,
+        MetricTolerance & tolerance);
+
+    /*
+     * The tolerances applied when none is specified for a metric: times and
+     * per-frame counters, but not the noisier frame time tails.
+     */
+    static std::vector<MetricTolerance> GetDefaults();
+};
+
+struct MetricComparison
+{
+    enum class ResultType
+    {
+        Unchanged,
+        Improved,
+        Regressed,
+        Missing
+    };
+
+    std::string Metric;
+    double Baseline;
+    double Current;
+    MetricTolerance Tolerance;
+    ResultType Result;
+};
+
+/*
+ * Compares each baseline metric that has a tolerance with the current run's.
+ *
+ * The tolerance of a metric is the one with the longest prefix of it among the
+ * specified tolerances, or - when none matches - among the default ones; metrics
+ * with no tolerance are not compared.
+ */
+std::vector<MetricComparison> CompareBenchReports(
+    BenchReport const & baseline,
+    BenchReport const & current,
+    std::vector<MetricTolerance> const & tolerances);
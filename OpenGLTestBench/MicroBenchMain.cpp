@@ -0,0 +1,230 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "NullRenderContext.h"
+#include "World.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace /* anonymous */ {
+
+    struct WorldSize
+    {
+        int Width;
+        int Height;
+
+        WorldSize(int width, int height)
+            : Width(width)
+            , Height(height)
+        {}
+    };
+
+    struct MicroBenchOptions
+    {
+        std::vector<WorldSize> WorldSizes;
+        size_t Iterations;
+
+        MicroBenchOptions()
+            : WorldSizes()
+            , Iterations(50u)
+        {}
+    };
+
+    void PrintUsage()
+    {
+        fprintf(stderr,
+            "Usage: OpenGLTestMicroBench [options]\n"
+            "  --world-size WxH  Mesh size in points; may be repeated (default: 140x110, 560x440, 1400x1100)\n"
+            "  --iterations N    Number of measured iterations of each loop (default: 50)\n");
+    }
+
+    bool ParseOptions(
+        int argc,
+        char ** argv,
+        MicroBenchOptions & options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string const arg(argv[i]);
+
+            if (arg == "--world-size" && i + 1 < argc)
+            {
+                int width, height;
+                if (!World::ParseWorldSize(argv[++i], width, height))
+                    return false;
+
+                options.WorldSizes.emplace_back(width, height);
+            }
+            else if (arg == "--iterations" && i + 1 < argc)
+            {
+                long const value = strtol(argv[++i], nullptr, 10);
+                if (value <= 0)
+                    return false;
+
+                options.Iterations = static_cast<size_t>(value);
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        if (options.WorldSizes.empty())
+        {
+            options.WorldSizes.emplace_back(World::DefaultWorldWidth, World::DefaultWorldHeight);
+            options.WorldSizes.emplace_back(World::DefaultWorldWidth * 4, World::DefaultWorldHeight * 4);
+            options.WorldSizes.emplace_back(World::DefaultWorldWidth * 10, World::DefaultWorldHeight * 10);
+        }
+
+        return true;
+    }
+
+    struct LoopResult
+    {
+        size_t WrittenElements;
+        double MedianNanoseconds;
+    };
+
+    /*
+     * Runs the loop once to warm up and to count the elements it writes, and
+     * then the specified number of times, measuring each run.
+     */
+    LoopResult MeasureLoop(
+        std::function<void(NullRenderContext &)> const & loop,
+        NullRenderContext & renderContext,
+        size_t iterations)
+    {
+        renderContext.ResetElementCount();
+        loop(renderContext);
+        size_t const writtenElements = renderContext.GetElementCount();
+
+        std::vector<double> times;
+        times.reserve(iterations);
+
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            auto const startTime = std::chrono::steady_clock::now();
+
+            loop(renderContext);
+
+            auto const endTime = std::chrono::steady_clock::now();
+
+            times.push_back(std::chrono::duration<double, std::nano>(endTime - startTime).count());
+        }
+
+        std::sort(times.begin(), times.end());
+
+        LoopResult result;
+        result.WrittenElements = writtenElements;
+        result.MedianNanoseconds = times[times.size() / 2];
+        return result;
+    }
+
+    // A sample of the springs, spread all over the world
+    constexpr size_t FlippedSpringStride = 97;
+
+    size_t GetFlippedSpringCount(World const & world)
+    {
+        return (world.GetSpringCount() + FlippedSpringStride - 1) / FlippedSpringStride;
+    }
+
+    void FlipSpringStresses(World & world)
+    {
+        for (size_t s = 0; s < world.GetSpringCount(); s += FlippedSpringStride)
+        {
+            world.SetSpringStressed(s, !world.IsSpringStressed(s));
+        }
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    MicroBenchOptions options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        PrintUsage();
+        return 2;
+    }
+
+    //
+    // The loops, each with the number of elements it scans; the time is reported
+    // per scanned element, which differs from the written elements for filtering
+    // loops such as the stressed springs'
+    //
+    // The stressed springs are only uploaded when they change; the stress_changes
+    // loop flips the stress of a sample of springs and renders the change.
+    //
+
+    struct Loop
+    {
+        char const * Name;
+        std::function<void(World &, NullRenderContext &)> Run;
+        std::function<size_t(World const &, size_t)> GetScannedElements;
+    };
+
+    auto const writtenElements = [](World const &, size_t written) { return written; };
+
+    std::vector<Loop> const loops = {
+        { "land", [](World & world, NullRenderContext & rc) { world.UploadLand(rc); }, writtenElements },
+        { "point_positions", [](World & world, NullRenderContext & rc) { world.UploadShipPointPositions(rc); }, writtenElements },
+        { "point_colours", [](World & world, NullRenderContext & rc) { world.UploadShipPointColours(rc); }, writtenElements },
+        { "topology", [](World & world, NullRenderContext & rc) { world.UploadShipTopology(rc); }, writtenElements },
+        { "stressed_springs", [](World & world, NullRenderContext & rc) { world.RenderStressedSprings(rc); }, [](World const & world, size_t) { return world.GetSpringCount(); } },
+        { "stress_changes", [](World & world, NullRenderContext & rc) { FlipSpringStresses(world); world.RenderStressedSprings(rc); }, [](World const & world, size_t) { return GetFlippedSpringCount(world); } },
+        { "water_surface", [](World & world, NullRenderContext & rc) { world.UploadWaterSurface(rc); }, writtenElements },
+        { "cpu_water", [](World & world, NullRenderContext & rc) { world.SetUseGpuWater(false); world.RenderWater(rc); }, writtenElements },
+    };
+
+    printf("[\n");
+
+    for (size_t s = 0; s < options.WorldSizes.size(); ++s)
+    {
+        WorldSize const & worldSize = options.WorldSizes[s];
+
+        std::unique_ptr<World> world = std::make_unique<World>(worldSize.Width, worldSize.Height);
+        NullRenderContext renderContext;
+
+        printf("  {\n");
+        printf("    \"world_width\": %d,\n", worldSize.Width);
+        printf("    \"world_height\": %d,\n", worldSize.Height);
+        printf("    \"points\": %zu,\n", world->GetPointCount());
+        printf("    \"springs\": %zu,\n", world->GetSpringCount());
+        printf("    \"triangles\": %zu,\n", world->GetTriangleCount());
+        printf("    \"loops\": {\n");
+
+        for (size_t l = 0; l < loops.size(); ++l)
+        {
+            World & w = *world;
+            LoopResult const result = MeasureLoop(
+                [&](NullRenderContext & rc) { loops[l].Run(w, rc); },
+                renderContext,
+                options.Iterations);
+
+            size_t const scannedElements = loops[l].GetScannedElements(w, result.WrittenElements);
+
+            printf("      \"%s\": { \"scanned\": %zu, \"written\": %zu, \"ns\": %.1f, \"ns_per_element\": %.3f }%s\n",
+                loops[l].Name,
+                scannedElements,
+                result.WrittenElements,
+                result.MedianNanoseconds,
+                scannedElements > 0 ? result.MedianNanoseconds / static_cast<double>(scannedElements) : 0.0,
+                l + 1 < loops.size() ? "," : "");
+        }
+
+        printf("    }\n");
+        printf("  }%s\n", s + 1 < options.WorldSizes.size() ? "," : "");
+    }
+
+    printf("]\n");
+
+    return 0;
+}
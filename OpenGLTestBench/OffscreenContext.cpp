@@ -0,0 +1,163 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "OffscreenContext.h"
+
+#include "GameException.h"
+
+#include <EGL/eglext.h>
+
+OffscreenContext::OffscreenContext(
+    int width,
+    int height)
+    : mWidth(width)
+    , mHeight(height)
+    , mDisplay(EGL_NO_DISPLAY)
+    , mContext(EGL_NO_CONTEXT)
+    , mFramebuffer(0u)
+    , mColorRenderbuffer(0u)
+    , mDepthRenderbuffer(0u)
+{
+    //
+    // Get a display
+    //
+
+    PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (nullptr != getPlatformDisplay)
+    {
+        mDisplay = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    }
+
+    if (EGL_NO_DISPLAY == mDisplay)
+    {
+        mDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+
+    EGLint eglMajor;
+    EGLint eglMinor;
+    if (EGL_NO_DISPLAY == mDisplay || !eglInitialize(mDisplay, &eglMajor, &eglMinor))
+    {
+        throw GameException("Cannot initialize EGL");
+    }
+
+    // From now on the display, and whatever else we get, has to be released if we fail
+    try
+    {
+        //
+        // Create context
+        //
+
+        EGLint const configAttributes[] = {
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+            EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+            EGL_NONE
+        };
+
+        EGLConfig config;
+        EGLint configCount;
+        if (!eglChooseConfig(mDisplay, configAttributes, &config, 1, &configCount) || configCount < 1)
+        {
+            throw GameException("Cannot find an EGL config supporting OpenGL");
+        }
+
+        if (!eglBindAPI(EGL_OPENGL_API))
+        {
+            throw GameException("Cannot bind the OpenGL API to EGL");
+        }
+
+        mContext = eglCreateContext(mDisplay, config, EGL_NO_CONTEXT, nullptr);
+        if (EGL_NO_CONTEXT == mContext)
+        {
+            throw GameException("Cannot create EGL context");
+        }
+
+        // No surface at all; we render to our own framebuffer object
+        if (!eglMakeCurrent(mDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, mContext))
+        {
+            throw GameException("Cannot make EGL context current without a surface");
+        }
+
+        if (!gladLoadGLLoader((GLADloadproc)eglGetProcAddress))
+        {
+            throw GameException("Failed to initialize GLAD");
+        }
+
+        //
+        // Create framebuffer
+        //
+
+        if (!GLAD_GL_EXT_framebuffer_object)
+        {
+            throw GameException("The OpenGL implementation does not support framebuffer objects");
+        }
+
+        glGenFramebuffersEXT(1, &mFramebuffer);
+        glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, mFramebuffer);
+
+        glGenRenderbuffersEXT(1, &mColorRenderbuffer);
+        glBindRenderbufferEXT(GL_RENDERBUFFER_EXT, mColorRenderbuffer);
+        glRenderbufferStorageEXT(GL_RENDERBUFFER_EXT, GL_RGBA8, mWidth, mHeight);
+        glFramebufferRenderbufferEXT(GL_FRAMEBUFFER_EXT, GL_COLOR_ATTACHMENT0_EXT, GL_RENDERBUFFER_EXT, mColorRenderbuffer);
+
+        glGenRenderbuffersEXT(1, &mDepthRenderbuffer);
+        glBindRenderbufferEXT(GL_RENDERBUFFER_EXT, mDepthRenderbuffer);
+        glRenderbufferStorageEXT(GL_RENDERBUFFER_EXT, GL_DEPTH_COMPONENT16, mWidth, mHeight);
+        glFramebufferRenderbufferEXT(GL_FRAMEBUFFER_EXT, GL_DEPTH_ATTACHMENT_EXT, GL_RENDERBUFFER_EXT, mDepthRenderbuffer);
+
+        if (GL_FRAMEBUFFER_COMPLETE_EXT != glCheckFramebufferStatusEXT(GL_FRAMEBUFFER_EXT))
+        {
+            throw GameException("Cannot create a complete framebuffer");
+        }
+    }
+    catch (...)
+    {
+        Release();
+        throw;
+    }
+
+    glViewport(0, 0, mWidth, mHeight);
+}
+
+OffscreenContext::~OffscreenContext()
+{
+    Release();
+}
+
+std::string OffscreenContext::GetRenderer() const
+{
+    char const * renderer = reinterpret_cast<char const *>(glGetString(GL_RENDERER));
+    return (nullptr != renderer) ? std::string(renderer) : std::string();
+}
+
+void OffscreenContext::Release()
+{
+    if (0u != mFramebuffer)
+    {
+        glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, 0);
+        glDeleteFramebuffersEXT(1, &mFramebuffer);
+    }
+
+    if (0u != mColorRenderbuffer)
+    {
+        glDeleteRenderbuffersEXT(1, &mColorRenderbuffer);
+    }
+
+    if (0u != mDepthRenderbuffer)
+    {
+        glDeleteRenderbuffersEXT(1, &mDepthRenderbuffer);
+    }
+
+    if (EGL_NO_DISPLAY != mDisplay)
+    {
+        eglMakeCurrent(mDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+
+        if (EGL_NO_CONTEXT != mContext)
+        {
+            eglDestroyContext(mDisplay, mContext);
+        }
+
+        eglTerminate(mDisplay);
+    }
+}
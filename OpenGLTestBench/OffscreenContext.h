@@ -0,0 +1,62 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "OpenGLTest.h"
+
+#include <EGL/egl.h>
+
+#include <string>
+
+/*
+ * An OpenGL context with no window and no display, rendering into a framebuffer
+ * object of the specified size.
+ *
+ * The context is created through EGL, preferring Mesa's surfaceless platform,
+ * which works on machines without a GPU by means of llvmpipe.
+ */
+class OffscreenContext
+{
+public:
+
+    OffscreenContext(
+        int width,
+        int height);
+
+    ~OffscreenContext();
+
+    OffscreenContext(OffscreenContext const & other) = delete;
+    OffscreenContext & operator=(OffscreenContext const & other) = delete;
+
+    int GetWidth() const
+    {
+        return mWidth;
+    }
+
+    int GetHeight() const
+    {
+        return mHeight;
+    }
+
+    std::string GetRenderer() const;
+
+private:
+
+    // Releases the framebuffer, the context and the display, as far as they were created
+    void Release();
+
+private:
+
+    int const mWidth;
+    int const mHeight;
+
+    EGLDisplay mDisplay;
+    EGLContext mContext;
+
+    GLuint mFramebuffer;
+    GLuint mColorRenderbuffer;
+    GLuint mDepthRenderbuffer;
+};